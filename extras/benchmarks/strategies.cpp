@@ -0,0 +1,105 @@
+/**
+ * @file   strategies.cpp
+ * @author Diego Paiva
+ * @date   18/10/2026
+ *
+ * Benchmark of the acceptance strategies of the local search operators. ILS is run several times per strategy on
+ * the given instance, run k being seeded with k under every strategy so that all strategies start from the same
+ * solutions. The mean convergence (time, cost) of the runs of every strategy is written as a gnuplot datablock.
+ */
+
+#include "algorithms.hpp"
+#include "instance.hpp"
+
+#include <fstream>   // std::ofstream
+#include <algorithm> // std::sort, std::upper_bound
+#include <iterator>  // std::prev
+#include <cfloat>    // DBL_MAX
+
+int main(const int argc, const char* argv[])
+{
+  const int min_args = 4, max_args = 6, args_given = argc - 1;
+
+  if (args_given < min_args || args_given > max_args) {
+    fprintf(
+      stderr, "Usage: %s <instance> <max iterations> <no improvement iterations> <output dat> [sample size] [runs]\n",
+      argv[0]
+    );
+    return EXIT_FAILURE;
+  }
+
+  Instance instance;
+
+  try {
+    instance.init(argv[1]);
+  }
+  catch (const std::exception &e) {
+    fprintf(stderr, "%s\n", e.what());
+    return EXIT_FAILURE;
+  }
+
+  int max_iterations = std::stoi(argv[2]);
+  int no_improvement_iterations = std::stoi(argv[3]);
+  int sample_size = args_given >= 5 ? std::stoi(argv[5]) : 16;
+  int num_runs = args_given >= 6 ? std::max(1, std::stoi(argv[6])) : 5;
+
+  std::vector<std::pair<std::string, algorithms::Strategy>> strategies = {
+    {"best", algorithms::Strategy(algorithms::Strategy::Type::BEST_IMPROVEMENT)},
+    {"first", algorithms::Strategy(algorithms::Strategy::Type::FIRST_IMPROVEMENT)},
+    {"sampled-" + std::to_string(sample_size), algorithms::Strategy(algorithms::Strategy::Type::SAMPLED, sample_size)}
+  };
+
+  std::ofstream data_stream(argv[4], std::ofstream::out | std::ofstream::trunc);
+
+  for (auto pair : strategies) {
+    std::vector<Run> runs;
+
+    for (int k = 0; k < num_runs; k++) {
+      algorithms::set_seed(k);
+      runs.push_back(algorithms::ils(instance, max_iterations, no_improvement_iterations, 0.2, 1, pair.second));
+    }
+
+    // The mean curve is sampled at every improvement of any run, once all runs have their first solution
+    std::vector<double> times;
+    double first_time = 0.0, mean_cost = 0.0, mean_seconds = 0.0;
+
+    for (const Run &run : runs) {
+      first_time = std::max(first_time, run.convergence.front().first);
+
+      for (auto point : run.convergence)
+        times.push_back(point.first);
+
+      mean_cost += run.best.cost/num_runs;
+      mean_seconds += run.elapsed_seconds/num_runs;
+    }
+
+    std::sort(times.begin(), times.end());
+
+    // Each datablock must be separated by two line breaks
+    data_stream << "# " << instance.name << ' ' << pair.first << ", mean of " << num_runs << " runs\n";
+
+    for (double t : times) {
+      if (t < first_time)
+        continue;
+
+      double cost = 0.0;
+
+      // Cost of every run at time t is the one of its last improvement until then
+      for (const Run &run : runs) {
+        auto point = std::upper_bound(
+          run.convergence.begin(), run.convergence.end(), std::make_pair(t, DBL_MAX)
+        );
+
+        cost += std::prev(point)->second/num_runs;
+      }
+
+      data_stream << t << ' ' << cost << '\n';
+    }
+
+    data_stream << mean_seconds << ' ' << mean_cost << "\n\n\n";
+
+    printf("%-6s %-12s c = %8.2f  t = %7.2fs\n", instance.name.c_str(), pair.first.c_str(), mean_cost, mean_seconds);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,170 @@
+/**
+ * @file   travel_times.cpp
+ * @author Diego Paiva
+ * @date   18/10/2026
+ *
+ * Benchmark of the storage modes of travel times. For every mode the instance is loaded without cache and the
+ * memory footprint, including the row cache of one thread unless dense, the largest error against exact distances, the cost of random lookups and of lookups between
+ * nearby nodes (as made by the local search) and, optionally, the time and cost of a seeded construction followed
+ * by VND are reported. Nodes may be renumbered for locality.
+ */
+
+#include "algorithms.hpp"
+#include "instance.hpp"
+
+#include <cmath>     // fabs
+#include <random>    // std::mt19937
+#include <algorithm> // std::shuffle, std::partial_sort
+#include <omp.h>     // omp_get_wtime
+
+// Sums of lookups are stored here so that they aren't optimized away
+volatile double sink;
+
+int main(const int argc, const char* argv[])
+{
+  const int min_args = 1, max_args = 4, args_given = argc - 1;
+
+  if (args_given < min_args || args_given > max_args) {
+    fprintf(stderr, "Usage: %s <instance> [lookups] [local search runs] [file | hilbert | time-window]\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  long long lookups = args_given >= 2 ? std::stoll(argv[2]) : 10000000;
+  int local_search_runs = args_given >= 3 ? std::stoi(argv[3]) : 1;
+  std::string ordering_name = args_given >= 4 ? argv[4] : "file";
+
+  Instance::Ordering ordering = Instance::Ordering::FILE;
+
+  if (ordering_name == "hilbert")
+    ordering = Instance::Ordering::HILBERT;
+  else if (ordering_name == "time-window")
+    ordering = Instance::Ordering::TIME_WINDOW;
+
+  std::vector<std::pair<std::string, TravelTimes::Mode>> modes = {
+    {"dense", TravelTimes::Mode::DENSE},
+    {"triangular", TravelTimes::Mode::TRIANGULAR},
+    {"float32", TravelTimes::Mode::FLOAT32},
+    {"quantized", TravelTimes::Mode::QUANTIZED},
+    {"lazy", TravelTimes::Mode::LAZY}
+  };
+
+  Instance exact;
+
+  try {
+    exact.init(argv[1], false, TravelTimes::Mode::LAZY);
+  }
+  catch (const std::exception &e) {
+    fprintf(stderr, "%s\n", e.what());
+    return EXIT_FAILURE;
+  }
+
+  int n = exact.nodes.size();
+
+  // Lookups follow the same random pairs in every mode
+  std::vector<std::pair<int, int>> pairs(1 << 20);
+  algorithms::details::Random::seed(0);
+
+  for (auto &pair : pairs)
+    pair = {algorithms::details::Random::get(0, n - 1), algorithms::details::Random::get(0, n - 1)};
+
+  // Local lookups go from every node, in random order, to its nearest nodes
+  const int neighbors = std::min(8, n - 1);
+  std::vector<int> order(n);
+  std::vector<std::pair<int, int>> local_pairs;
+
+  for (int i = 0; i < n; i++)
+    order[i] = i;
+
+  std::shuffle(order.begin(), order.end(), std::mt19937(0));
+
+  for (int i : order) {
+    std::vector<std::pair<double, int>> distances;
+
+    for (int j = 0; j < n; j++)
+      if (j != i)
+        distances.push_back({exact.get_travel_time(exact.nodes[i], exact.nodes[j]), j});
+
+    std::partial_sort(distances.begin(), distances.begin() + neighbors, distances.end());
+
+    for (int k = 0; k < neighbors; k++)
+      local_pairs.push_back({i, distances[k].second});
+  }
+
+  printf("%-6s %d nodes, %lld lookups, %s ordering\n", exact.name.c_str(), n, lookups, ordering_name.c_str());
+  printf(
+    "%-10s %10s %8s %10s %12s %12s %10s %8s\n", "mode", "MB", "init (s)", "max error", "random (ns)", "local (ns)",
+    "cost", "ls (s)"
+  );
+
+  for (auto pair : modes) {
+    Instance instance;
+    double start = omp_get_wtime();
+
+    instance.init(argv[1], false, pair.second, "", ordering);
+
+    double init_seconds = omp_get_wtime() - start;
+    double max_error = 0.0;
+
+    for (int i = 0; i < n; i++)
+      for (int j = 0; j < n; j++)
+        max_error = std::max(max_error, fabs(instance.get_travel_time(instance.nodes[i], instance.nodes[j]) -
+                                             exact.get_travel_time(exact.nodes[i], exact.nodes[j])));
+
+    double sum = 0.0;
+    start = omp_get_wtime();
+
+    for (long long k = 0; k < lookups; k++) {
+      const std::pair<int, int> &p = pairs[k & (pairs.size() - 1)];
+      sum += instance.get_travel_time(instance.nodes[p.first], instance.nodes[p.second]);
+    }
+
+    double lookup_ns = (omp_get_wtime() - start) * 1e9/std::max(lookups, 1LL);
+    sink = sum;
+
+    sum = 0.0;
+    start = omp_get_wtime();
+
+    for (long long k = 0; k < lookups; k++) {
+      const std::pair<int, int> &p = local_pairs[k % local_pairs.size()];
+      sum += instance.get_travel_time(instance.nodes[p.first], instance.nodes[p.second]);
+    }
+
+    double local_lookup_ns = (omp_get_wtime() - start) * 1e9/std::max(lookups, 1LL);
+    sink = sum;
+
+    double cost = 0.0, local_search_seconds = 0.0;
+
+    for (int run = 0; run < local_search_runs; run++) {
+      algorithms::details::Random::seed(run);
+      start = omp_get_wtime();
+
+      Solution s;
+
+      do {
+        s = algorithms::details::construct_greedy_randomized_solution(instance, 0.2);
+
+        if (!s.feasible())
+          s = algorithms::details::repair(s);
+      }
+      while (!s.feasible());
+
+      s = algorithms::details::vnd(s);
+
+      local_search_seconds += omp_get_wtime() - start;
+      cost += s.cost;
+    }
+
+    if (local_search_runs > 0) {
+      cost /= local_search_runs;
+      local_search_seconds /= local_search_runs;
+    }
+
+    printf(
+      "%-10s %10.2f %8.3f %10.2e %12.2f %12.2f %10.2f %8.2f\n", pair.first.c_str(),
+      (instance.travel_times.get_size() + instance.travel_times.get_cache_size())/1048576.0, init_seconds, max_error, lookup_ns, local_lookup_ns, cost,
+      local_search_seconds
+    );
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,24 @@
+#!/bin/bash
+
+# Compare the cost-vs-time curves of the local search acceptance strategies on every instance.
+#
+# Usage (from the repository root, after building in 'build'):
+#   extras/scripts/bash/strategies.sh [max iterations] [no improvement iterations] [sample size] [runs]
+
+max_iterations=${1:-2000}
+no_improvement_iterations=${2:-250}
+sample_size=${3:-16}
+runs=${4:-5}
+
+results=data/results/strategies
+mkdir -p $results
+
+for instance in data/instances/*.txt; do
+  name=$(basename $instance .txt)
+
+  build/strategies.exe $instance $max_iterations $no_improvement_iterations $results/$name.dat $sample_size $runs
+
+  if command -v gnuplot > /dev/null; then
+    gnuplot -c extras/scripts/gnuplot/strategies.gp $results/$name.dat $results/$name.png
+  fi
+done
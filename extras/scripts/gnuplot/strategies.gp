@@ -0,0 +1,21 @@
+# Deletes any user-defined variables and functions and restores default settings
+reset session
+
+# Produce PNG output. The 'enhanced' keyword adds support for additional text formatting
+set term pngcairo dashed size 600, 350 enhanced font "Verdana, 12"
+
+# Where the image will be stored
+set output ARG2
+
+set grid
+
+set ytics nomirror
+set xtics nomirror
+
+set xlabel "Time (seconds)"
+set ylabel "Objective"
+
+# One datablock per acceptance strategy: best, first and sampled
+plot ARG1 i 0 u 1:2 w steps lc rgb "#ff0000" lw 2 t "Best improvement", \
+     ARG1 i 1 u 1:2 w steps lc rgb "#00008B" lw 2 t "First improvement", \
+     ARG1 i 2 u 1:2 w steps lc rgb "#008B00" lw 2 t "Sampled"
@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+
+# This script converts a text travel time matrix into the binary format read by the solver (see travel_times.hpp).
+# A dense matrix is given as one row of whitespace-separated travel times per line, a sparse one as "i j time"
+# triplets, one per line, in which case the travel time of missing pairs must be given as well:
+#
+#   matrix.py dense  <input> <output>
+#   matrix.py sparse <input> <output> <nodes> <default time>
+
+# Standard libraries
+import sys
+import struct
+
+if sys.version_info < (3, 0, 0):
+  sys.stderr.write("You need python 3.0.0 or later to run this script\n")
+  exit(1)
+
+# Fields of the header: magic, version, byte order, format, nodes, entries and default time
+HEADER = "=8sIIIiQd"
+
+def write_dense(input_path, output_path):
+  rows = []
+
+  with open(input_path, 'r') as file:
+    for line in file:
+      if line.strip():
+        rows.append([float(t) for t in line.split()])
+
+  n = len(rows)
+
+  if any(len(row) != n for row in rows):
+    print("Error: matrix is not square")
+    exit(1)
+
+  with open(output_path, 'wb') as file:
+    file.write(struct.pack(HEADER, b"DARPTTM", 1, 0x01020304, 0, n, n * n, 0.0))
+
+    for row in rows:
+      file.write(struct.pack("=%dd" % n, *row))
+
+def write_sparse(input_path, output_path, n, default_time):
+  rows = [dict() for i in range(n)]
+
+  with open(input_path, 'r') as file:
+    for line in file:
+      if line.strip():
+        i, j, t = line.split()
+        rows[int(i)][int(j)] = float(t)
+
+  offsets, columns, values = [0], [], []
+
+  # Columns must be strictly increasing within a row
+  for row in rows:
+    for j in sorted(row):
+      columns.append(j)
+      values.append(row[j])
+
+    offsets.append(len(columns))
+
+  with open(output_path, 'wb') as file:
+    file.write(struct.pack(HEADER, b"DARPTTM", 1, 0x01020304, 1, n, len(columns), default_time))
+    file.write(struct.pack("=%dQ" % len(offsets), *offsets))
+    file.write(struct.pack("=%di" % len(columns), *columns))
+
+    # Travel times are aligned to 8 bytes
+    if len(columns) % 2 == 1:
+      file.write(struct.pack("=i", 0))
+
+    file.write(struct.pack("=%dd" % len(values), *values))
+
+if len(sys.argv) == 4 and sys.argv[1] == "dense":
+  write_dense(sys.argv[2], sys.argv[3])
+elif len(sys.argv) == 6 and sys.argv[1] == "sparse":
+  write_sparse(sys.argv[2], sys.argv[3], int(sys.argv[4]), float(sys.argv[5]))
+else:
+  print("Usage: " + sys.argv[0] + " dense <input> <output>")
+  print("       " + sys.argv[0] + " sparse <input> <output> <nodes> <default time>")
+  exit(1)
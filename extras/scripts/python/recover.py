@@ -0,0 +1,68 @@
+#!/usr/bin/env python3
+
+# This script recovers the output of an interrupted execution. Runs are written to the output file as soon as they
+# finish, so a crash only leaves the document truncated after its last complete run. The truncated tail is dropped
+# and the open containers are closed, giving a valid JSON document with every complete run:
+#
+#   recover.py <input json> <output json>
+
+# Standard libraries
+import sys
+import json
+
+if sys.version_info < (3, 0, 0):
+  sys.stderr.write("You need python 3.0.0 or later to run this script\n")
+  exit(1)
+
+# Depth of the values that are runs: inside the outermost object and the "runs" container
+RUN_DEPTH = 2
+
+def recover(text):
+  stack = []
+  in_string = escaped = False
+
+  # End of the last complete run and the containers open at that point
+  end, open_containers = None, None
+
+  for i, c in enumerate(text):
+    if in_string:
+      if escaped:
+        escaped = False
+      elif c == '\\':
+        escaped = True
+      elif c == '"':
+        in_string = False
+    elif c == '"':
+      in_string = True
+    elif c in "{[":
+      stack.append(c)
+    elif c in "}]":
+      stack.pop()
+
+      if len(stack) == RUN_DEPTH:
+        end, open_containers = i + 1, list(stack)
+
+      # The document is complete
+      if not stack:
+        return text[:i + 1]
+
+  if end is None:
+    print("Error: no complete run found")
+    exit(1)
+
+  closing = "".join('}' if c == '{' else ']' for c in reversed(open_containers))
+
+  return text[:end] + closing
+
+if len(sys.argv) != 3:
+  print("Usage: " + sys.argv[0] + " <input json> <output json>")
+  exit(1)
+
+with open(sys.argv[1], 'r') as file:
+  document = recover(file.read())
+
+# Make sure the result parses before writing it
+json.loads(document)
+
+with open(sys.argv[2], 'w') as file:
+  file.write(document + '\n')
@@ -10,27 +10,209 @@
 #include "run.hpp"
 #include "random.hpp"
 
+#include <cfloat>        // FLT_MAX, DBL_MAX
+#include <unordered_set> // std::unordered_set
+
 namespace algorithms
 {
+ /**
+  * Acceptance strategy of the local search operators.
+  */
+  struct Strategy
+  {
+   /**
+    * Enumeration of possible strategies: apply the best of all moves, apply the first improving move found
+    * or apply the best of `sample_size` randomly sampled moves.
+    */
+    enum class Type {BEST_IMPROVEMENT, FIRST_IMPROVEMENT, SAMPLED};
+
+   /**
+    * Largest number of requests of a resequenced route. The time of `resequence` grows about 3.5 times with every
+    * request, from about 1 ms for 6 requests to 16 ms for 8 and 0.2 s for 10 on R10b, which is too slow for VND.
+    */
+    static const int max_resequencing_size = 8;
+
+    Type type;
+    int sample_size;
+    int resequencing_size;
+
+   /**
+    * Constructor.
+    *
+    * @param type              Strategy type.
+    * @param sample_size       Number of sampled moves (only used by `Type::SAMPLED`).
+    * @param resequencing_size Routes with up to this many requests are resequenced by `reinsert`, at most
+    *                          `max_resequencing_size`.
+    */
+    Strategy(Type type = Type::BEST_IMPROVEMENT, int sample_size = 0, int resequencing_size = 6) :
+      type(type), sample_size(sample_size),
+      resequencing_size(resequencing_size < max_resequencing_size ? resequencing_size : max_resequencing_size) {};
+  };
+
+ /**
+  * Cooling schedules of the simulated annealing: the temperature either decays geometrically to a fraction of the
+  * initial one or is adjusted to track a target acceptance rate of worsening moves which decreases along the run.
+  */
+  enum class Cooling {GEOMETRIC, ADAPTIVE};
+
+ /**
+  * Make the following runs started by the calling thread reproducible. Instead of with `std::random_device`, the
+  * Random engine of thread t of a run is seeded with `seed + t` and helper threads, such as the recombiner of GRASP,
+  * with `seed` plus the number of threads.
+  *
+  * @param seed Seed of the first thread.
+  */
+  void set_seed(unsigned int seed);
+
+ /**
+  * Limit the wall time of the following runs. Every algorithm stops once the limit is reached, whatever its number
+  * of iterations, and returns the best solution found so far. The limit is checked between iterations and inside
+  * the local search and the constructive algorithms, except for the constructions of every thread until it holds a
+  * feasible solution, which are always completed so that every run has a solution. The limit can thus be exceeded by
+  * the time of these constructions.
+  *
+  * @param seconds Time limit in seconds, none if zero.
+  */
+  void set_time_limit(double seconds);
+
  /**
   * Use GRASP to solve the instance.
   *
-  * @param iterations   Total number of iterations.
-  * @param random_param Randomness parameter to be used in the constructive algorithm.
-  * @param thread_count Number of threads to run.
-  * @return             A Run object.
+  * @param instance      Instance to be solved.
+  * @param iterations    Total number of iterations.
+  * @param random_param  Randomness parameter to be used in the constructive algorithm.
+  * @param thread_count  Number of threads to run.
+  * @param regret_k      Number of routes considered by the regret ranking of the constructive algorithm.
+  * @param pool_capacity If positive, local optima feed a route pool of this capacity, which is recombined into new
+  *                      solutions by a set-partitioning heuristic running in another thread.
+  * @return              A Run object.
+  */
+  Run grasp(Instance &instance, int iterations, double random_param, int thread_count, int regret_k = 1,
+            int pool_capacity = 0);
+
+ /**
+  * Use a pipelined GRASP to solve the instance: constructor threads feed a bounded queue of starting
+  * solutions which is consumed by local search threads. Duplicate and dominated starts are filtered
+  * before reaching the local search.
+  *
+  * @details Constructor threads help with the local search whenever the queue is full and once
+  *          all constructions are done.
+  *
+  * @param instance            Instance to be solved.
+  * @param iterations          Total number of constructions.
+  * @param random_param        Randomness parameter to be used in the constructive algorithm.
+  * @param constructor_count   Number of constructor threads.
+  * @param local_search_count  Number of local search threads.
+  * @param dominance_tolerance A start is dominated if its cost exceeds the best start cost by this fraction.
+  * @param regret_k            Number of routes considered by the regret ranking of the constructive algorithm.
+  * @return                    A Run object.
   */
-  Run grasp(int iterations, double random_param, int thread_count);
+  Run pipelined_grasp(Instance &instance, int iterations, double random_param, int constructor_count,
+                      int local_search_count, double dominance_tolerance = 0.1, int regret_k = 1);
+
+ /**
+  * Use Reactive GRASP to solve the instance. The randomness parameter of each iteration is drawn from a
+  * discrete set of alphas, whose probabilities are periodically updated from the quality of the solutions
+  * they produced, as in (Prais and Ribeiro, 2000).
+  *
+  * @param instance      Instance to be solved.
+  * @param iterations    Total number of iterations.
+  * @param block_size    Number of iterations between probability updates, at least 1.
+  * @param alphas        Candidate values for the randomness parameter.
+  * @param thread_count  Number of threads to run.
+  * @param amplification Exponent used to emphasize differences among alphas when updating probabilities.
+  * @param regret_k      Number of routes considered by the regret ranking of the constructive algorithm.
+  * @return              A Run object, including statistics of every alpha.
+  */
+  Run reactive_grasp(Instance &instance, int iterations, int block_size, std::vector<double> alphas, int thread_count,
+                     double amplification = 10.0, int regret_k = 1);
 
  /**
   * Use Iterated Local Search (ILS) to solve the instance.
   *
+  * @param instance                  Instance to be solved.
   * @param max_iterations            Maximum number of iterations.
   * @param no_improvement_iterations Number of iterations without improvement.
   * @param random_param              Randomness parameter to be used in the constructive algorithm.
+  * @param regret_k                  Number of routes considered by the regret ranking of the constructive algorithm.
+  * @param strategy                  Acceptance strategy of the local search operators.
+  * @return                          A Run object.
+  */
+  Run ils(Instance &instance, int max_iterations, int no_improvement_iterations, double random_param, int regret_k = 1,
+          Strategy strategy = Strategy());
+
+ /**
+  * Use Adaptive Large Neighborhood Search (ALNS) to solve the instance, as in (Ropke and Pisinger, 2006).
+  * Destroy and repair operators are chosen by roulette wheel with adaptive weights and new solutions are
+  * accepted with a simulated annealing criterion.
+  *
+  * @details Iterations run at about 165 per second on R10a, after an initial construction of about 3 s, rather than
+  *          the thousands per second of insertion heuristics with constant-time feasibility checks. Repairs insert
+  *          every removed request through `insert_requests`. Every feasible-looking insertion position is then
+  *          checked by the eight-step evaluation of the whole route, which makes about 2600 route evaluations per
+  *          iteration.
+  *
+  * @param instance        Instance to be solved.
+  * @param iterations      Total number of iterations.
+  * @param segment_size    Number of iterations between updates of the operator weights.
+  * @param reaction_factor How fast operator weights react to their scores, in range [0, 1].
+  * @param cooling_rate    Simulated annealing cooling rate, applied every iteration.
+  * @param max_removal     Maximum fraction of requests removed by a destroy operator.
+  * @param random_param    Randomness parameter to be used in the constructive algorithm.
+  * @return                A Run object.
+  */
+  Run alns(Instance &instance, int iterations, int segment_size = 100, double reaction_factor = 0.1,
+           double cooling_rate = 0.9997, double max_removal = 0.15, double random_param = 0.2);
+
+ /**
+  * Use a penalized search to solve the instance. Constraint violations are allowed and priced in the objective
+  * function by self-adjusting weights, as in (Cordeau and Laporte, 2003), so the search may cross infeasible
+  * regions instead of repairing solutions or activating extra vehicles.
+  *
+  * @details The initial solution of the Run is the first feasible one reached, since the penalized construction
+  *          seldom is, or the fallback construction if none was.
+  *
+  * @param instance                  Instance to be solved.
+  * @param max_iterations            Maximum number of iterations.
+  * @param no_improvement_iterations Number of iterations without improvement.
+  * @param adjustment                Weights of violated constraints are multiplied by (1 + adjustment) after every
+  *                                  iteration, while the other weights are divided by it.
+  * @param max_removal               Maximum fraction of requests relocated by the perturbation.
   * @return                          A Run object.
   */
-  Run ils(int max_iterations, int no_improvement_iterations, double random_param);
+  Run penalized_search(Instance &instance, int max_iterations, int no_improvement_iterations, double adjustment = 0.5,
+                       double max_removal = 0.1);
+
+ /**
+  * Use Tabu Search to solve the instance, as in (Cordeau and Laporte, 2003). Every iteration shifts a request to
+  * another route over the penalized objective function of `penalized_search`. Moving a request back to a route it
+  * recently left is tabu unless it yields a new best solution, and non-improving moves are penalized by the
+  * frequency of their (request, route) attribute.
+  *
+  * @param instance        Instance to be solved.
+  * @param iterations      Total number of iterations.
+  * @param tenure          Number of iterations an attribute stays tabu, 7.5 log10(n) in the paper.
+  * @param thread_count    Number of threads evaluating the neighborhood.
+  * @param diversification Scaling factor of the frequency penalty.
+  * @param adjustment      Violation weights are multiplied or divided by (1 + adjustment) after every iteration.
+  * @return                A Run object.
+  */
+  Run tabu(Instance &instance, int iterations, int tenure, int thread_count = 1, double diversification = 0.015,
+           double adjustment = 0.5);
+
+ /**
+  * Use Simulated Annealing to solve the instance. Every iteration samples a random relocate, exchange or 2-opt*
+  * move whose travel cost delta is computed in constant time. Once the move passes the acceptance criterion, the
+  * modified routes are screened for time windows and capacity from the first modified position on, until their
+  * earliest service times meet those of the unmodified tail, and only routes passing it are evaluated.
+  *
+  * @param instance     Instance to be solved.
+  * @param iterations   Total number of sampled moves.
+  * @param cooling      Cooling schedule.
+  * @param random_param Randomness parameter to be used in the constructive algorithm.
+  * @return             A Run object.
+  */
+  Run sa(Instance &instance, int iterations, Cooling cooling = Cooling::GEOMETRIC, double random_param = 0.2);
 
   namespace details
   {
@@ -40,17 +222,138 @@ namespace algorithms
     typedef effolkronium::random_thread_local Random;
 
    /**
-    * Define as "Move" a method that receives a Solution and returns another Solution.
+    * Set of routes, identified by their vehicles.
+    */
+    typedef std::unordered_set<Vehicle*, VehicleHash> RouteSet;
+
+   /**
+    * Define as "Move" a method that receives a Solution (along with the routes worth exploring and the acceptance
+    * strategy) and returns another Solution.
+    */
+    typedef Solution (*Move)(Solution s, const RouteSet *modified, Strategy strategy);
+
+   /**
+    * Define as "Destroy" a method that removes up to `q` requests from a Solution and returns them.
     */
-    typedef Solution (*Move)(Solution s);
+    typedef std::vector<Request*> (*Destroy)(Solution &s, int q);
+
+   /**
+    * Define as "Repair" a method that inserts requests in a Solution and returns `false` if it failed to do so.
+    */
+    typedef bool (*Repair)(Solution &s, std::vector<Request*> requests);
+
+   /**
+    * Get the seed of the first thread of a run started by the calling thread: the one set by `set_seed` or, if none
+    * was set, one drawn from `std::random_device`. The other threads of the run add their number to it.
+    *
+    * @return A seed.
+    */
+    unsigned int get_seed();
+
+   /**
+    * Get the wall time at which a run must stop according to the time limit set by `set_time_limit`.
+    *
+    * @param start Start time of the run, as given by `omp_get_wtime`.
+    * @return      Deadline of the run, DBL_MAX if there is no time limit.
+    */
+    double get_deadline(double start);
+
+   /**
+    * Check whether a run has reached the time limit set by `set_time_limit`.
+    *
+    * @param start Start time of the run, as given by `omp_get_wtime`.
+    * @return      `true` if the run must stop.
+    */
+    bool out_of_time(double start);
+
+   /**
+    * Weights of every kind of constraint violation in the penalized objective function.
+    */
+    struct Penalty
+    {
+      double load;
+      double time_window;
+      double ride_time;
+      double route_duration;
+
+     /**
+      * Default constructor, every violation starts with unit weight.
+      */
+      Penalty() : load(1.0), time_window(1.0), ride_time(1.0), route_duration(1.0) {};
+
+     /**
+      * Get the penalized cost of a route evaluated without early exit.
+      *
+      * @param r A route.
+      * @return  Travel cost plus weighted violations.
+      */
+      double cost(const Route &r) const;
+
+     /**
+      * Get the penalized cost of a solution whose routes were evaluated without early exit.
+      *
+      * @param s A solution.
+      * @return  Travel cost plus weighted violations.
+      */
+      double cost(const Solution &s) const;
+
+     /**
+      * Increase the weights of constraints violated by a solution and decrease the other ones.
+      *
+      * @param s          A solution.
+      * @param adjustment Weights are multiplied or divided by (1 + adjustment).
+      */
+      void update(const Solution &s, double adjustment);
+    };
 
    /**
     * Construct a random greedy solution.
     *
+    * @details With `regret_k` > 1, candidates are ranked by their regret-k value (the summed difference between
+    *          the cheapest insertion and the k - 1 next best routes) rather than by insertion cost. Insertions of
+    *          all candidates are evaluated in parallel at every step.
+    *
+    * @param instance     Instance to be solved.
     * @param random_param A random parameter in range [0, 1] to allow restricted selection from the candidate list.
-    * @return             A Solution.
+    * @param regret_k     Number of best routes considered by the regret ranking (1 ranks by insertion cost).
+    * @param deadline     Wall time, as given by `omp_get_wtime`, at which the construction is abandoned.
+    * @return             A Solution, with cost FLT_MAX if abandoned before every request was inserted.
+    */
+    Solution construct_greedy_randomized_solution(Instance &instance, double random_param, int regret_k = 1,
+                                                  double deadline = DBL_MAX);
+
+   /**
+    * Insert requests in a solution, one at a time, choosing from a restricted candidate list ranked as in
+    * the constructive algorithm. The cheapest insertion of every request in every route is cached, so only
+    * the modified route is evaluated again after each insertion.
+    *
+    * @param s                  A solution to be updated.
+    * @param requests           Requests to be inserted.
+    * @param random_param       A random parameter in range [0, 1] to allow restricted selection from the candidate list.
+    * @param regret_k           Number of best routes considered by the regret ranking (1 ranks by insertion cost).
+    * @param allow_new_vehicles Activate a new vehicle when a request has no feasible insertion.
+    * @param deadline           Wall time, as given by `omp_get_wtime`, at which insertions stop.
+    * @return                   `false` if some request could not be inserted, either because new vehicles are not
+    *                           allowed or because the deadline was reached.
     */
-    Solution construct_greedy_randomized_solution(double random_param);
+    bool insert_requests(Solution &s, std::vector<Request*> requests, double random_param, int regret_k,
+                         bool allow_new_vehicles, double deadline = DBL_MAX);
+
+   /**
+    * Insert a request in a solution through a bounded-depth ejection chain: if the request can't be inserted, another
+    * request is ejected to make room for it and recursively reinserted the same way.
+    *
+    * @details Ejections are tried in increasing order of an insertion lower bound and only for requests with
+    *          compatible time windows. Failed states are memoized by solution and request.
+    *
+    * @param s        A solution to be updated (only if the chain succeeds).
+    * @param req      A request to be inserted.
+    * @param modified If not null, receives the routes modified by the chain.
+    * @param depth    Maximum number of ejections in the chain.
+    * @param breadth  Maximum number of feasible ejections tried at each step of the chain.
+    * @return         `true` if the request was inserted.
+    */
+    bool insert_with_ejections(Solution &s, Request *req, RouteSet *modified = nullptr, int depth = 2, int breadth = 5);
 
    /**
     * Repair an infeasible solution.
@@ -90,38 +393,215 @@ namespace algorithms
     */
     Route get_cheapest_insertion(Request *req, Route r);
 
+   /**
+    * For a given request and a given route, return the route configuration with the request inserted at the
+    * position of least penalized cost. Every position is allowed, regardless of constraint violations.
+    *
+    * @details If returned route has MAXFLOAT cost, then no position has a penalized cost below `bound`. Positions
+    *          are ranked by a lower bound made of the exact load violation and the time window violations of the
+    *          earliest service beginning times, and routes are only evaluated while that bound beats the best one.
+    *
+    * @param req     A request to be inserted.
+    * @param r       A route evaluated without early exit.
+    * @param penalty Violation weights.
+    * @param bound   Only positions of penalized cost below this value are considered.
+    * @return        A route with the request inserted, evaluated without early exit.
+    */
+    Route get_cheapest_penalized_insertion(Request *req, Route r, const Penalty &penalty, double bound = FLT_MAX);
+
+   /**
+    * Construct a solution with the available fleet only, inserting requests in random order at their positions
+    * of least penalized cost.
+    *
+    * @param instance Instance to be solved.
+    * @param penalty  Violation weights.
+    * @param deadline Wall time, as given by `omp_get_wtime`, at which the construction is abandoned.
+    * @return         A solution whose routes were evaluated without early exit, possibly violating constraints, with
+    *                 cost FLT_MAX if abandoned before every request was inserted.
+    */
+    Solution construct_penalized_solution(Instance &instance, const Penalty &penalty, double deadline = DBL_MAX);
+
+   /**
+    * Check if a route evaluated without early exit violates any constraint.
+    *
+    * @param r A route.
+    * @return  `true` if violated.
+    */
+    bool violated(const Route &r);
+
+   /**
+    * Check if a solution whose routes were evaluated without early exit violates any constraint.
+    *
+    * @param s A solution.
+    * @return  `true` if violated.
+    */
+    bool violated(const Solution &s);
+
+   /**
+    * Relocate requests to their positions of least penalized cost until no relocation improves the solution.
+    *
+    * @param s        A solution whose routes were evaluated without early exit.
+    * @param penalty  Violation weights.
+    * @param deadline Wall time, as given by `omp_get_wtime`, after which no other request is relocated.
+    * @return         Updated solution.
+    */
+    Solution penalized_descent(Solution s, const Penalty &penalty, double deadline = DBL_MAX);
+
+   /**
+    * Remove a request from the route of vehicle `v` in a given solution.
+    *
+    * @param s   A solution to be updated.
+    * @param v   Vehicle whose route contains the request.
+    * @param req The request.
+    */
+    void remove_request(Solution &s, Vehicle *v, Request *req);
+
+   /**
+    * Map each request of a solution to the vehicle which serves it.
+    *
+    * @param s A solution.
+    * @return  Hash map from request to vehicle.
+    */
+    std::unordered_map<Request*, Vehicle*, RequestHash> get_assignments(Solution &s);
+
+   /**
+    * ALNS destroy operator: remove `q` random requests.
+    *
+    * @param s A solution to be updated.
+    * @param q Number of requests to be removed.
+    * @return  Removed requests.
+    */
+    std::vector<Request*> random_removal(Solution &s, int q);
+
+   /**
+    * ALNS destroy operator: remove `q` requests, favouring those whose removal saves the most.
+    *
+    * @param s A solution to be updated.
+    * @param q Number of requests to be removed.
+    * @return  Removed requests.
+    */
+    std::vector<Request*> worst_removal(Solution &s, int q);
+
+   /**
+    * ALNS destroy operator: remove `q` requests related by location and time windows (Shaw, 1998).
+    *
+    * @param s A solution to be updated.
+    * @param q Number of requests to be removed.
+    * @return  Removed requests.
+    */
+    std::vector<Request*> shaw_removal(Solution &s, int q);
+
+   /**
+    * ALNS destroy operator: remove every request of a random route.
+    *
+    * @param s A solution to be updated.
+    * @param q Ignored, the size of the route determines how many requests are removed.
+    * @return  Removed requests.
+    */
+    std::vector<Request*> route_removal(Solution &s, int q);
+
+   /**
+    * ALNS repair operator: insert requests at their cheapest positions, cheapest first.
+    *
+    * @param s        A solution to be updated.
+    * @param requests Requests to be inserted.
+    * @return         `false` if some request could not be inserted.
+    */
+    bool greedy_insertion(Solution &s, std::vector<Request*> requests);
+
+   /**
+    * ALNS repair operator: insert requests at their cheapest positions, highest regret-3 value first.
+    *
+    * @param s        A solution to be updated.
+    * @param requests Requests to be inserted.
+    * @return         `false` if some request could not be inserted.
+    */
+    bool regret_insertion(Solution &s, std::vector<Request*> requests);
+
    /**
     * Implementation of Variable Neighborhood Descent procedure.
     *
     * @param s              A solution to be updated.
     * @param use_randomness Set to RVND (moves will be chosen randomly rather than the order they appear in vector).
+    * @param strategy       Acceptance strategy of the moves.
+    * @param deadline       Wall time, as given by `omp_get_wtime`, after which no other move is explored.
     * @return               Updated solution.
     */
-    Solution vnd(Solution s, bool use_randomness = false);
+    Solution vnd(Solution s, bool use_randomness = false, Strategy strategy = Strategy(), double deadline = DBL_MAX);
 
    /**
-    * Update a given solution by performing the "reinsert" movement.
+    * Update a given solution by performing the "reinsert" movement. Routes with up to `strategy.resequencing_size`
+    * requests are resequenced by `resequence` instead.
     *
-    * @param s A solution to be updated.
-    * @return  Updated solution.
+    * @param s        A solution to be updated.
+    * @param modified If not null, only routes in this set are explored.
+    * @param strategy Acceptance strategy.
+    * @return         Updated solution.
+    */
+    Solution reinsert(Solution s, const RouteSet *modified = nullptr, Strategy strategy = Strategy());
+
+   /**
+    * Resequence the requests of a route heuristically by dynamic programming over states (visited nodes, last
+    * node), which also determine the load. Every state keeps its labels (cost, departure time) not dominated by
+    * another label, departing as early as possible, and sequences are checked by the eight-step scheme in increasing
+    * order of cost.
+    *
+    * @details Labels only account for capacity, precedence and time windows. A label may thus be discarded for one
+    *          which later violates a ride time or the route duration, so the cheapest feasible sequence can be
+    *          missed, although the result is never worse than `r`.
+    *
+    * @param r A feasible route.
+    * @return  Cheapest feasible sequence found, or `r` itself if there's no cheaper one.
+    */
+    Route resequence(const Route &r);
+
+   /**
+    * Update a given solution by performing the intra-route "or-opt" movement, which relocates a zero-load block (a
+    * segment the vehicle starts and ends empty) to another position between blocks of the same route.
+    *
+    * @details Time window feasibility of every move is checked in constant time by concatenating segment data
+    *          of the blocks, as in (Vidal et al., 2013). Routes are only evaluated for improving moves which pass it.
+    *
+    * @param s        A solution to be updated.
+    * @param modified If not null, only routes in this set are explored.
+    * @param strategy Acceptance strategy.
+    * @return         Updated solution.
     */
-    Solution reinsert(Solution s);
+    Solution or_opt(Solution s, const RouteSet *modified = nullptr, Strategy strategy = Strategy());
 
    /**
     * Update a given solution by performing the "shift(1,0)" movement.
     *
-    * @param s A solution to be updated.
-    * @return  Updated solution.
+    * @param s        A solution to be updated.
+    * @param modified If not null, only pairs of routes with at least one route in this set are explored.
+    * @param strategy Acceptance strategy.
+    * @return         Updated solution.
     */
-    Solution shift_1_0(Solution s);
+    Solution shift_1_0(Solution s, const RouteSet *modified = nullptr, Strategy strategy = Strategy());
+
+   /**
+    * Update a given solution by performing the "swap(1,1)" movement, which exchanges two requests between routes.
+    *
+    * @details Routes without each request are computed once and shared by all swaps involving it. Swaps whose removal
+    *          gains plus a lower bound on the insertion costs can't beat the best swap found are skipped, and so are
+    *          swaps between requests with incompatible time windows.
+    *
+    * @param s        A solution to be updated.
+    * @param modified If not null, only pairs of routes with at least one route in this set are explored.
+    * @param strategy Acceptance strategy.
+    * @return         Updated solution.
+    */
+    Solution swap_1_1(Solution s, const RouteSet *modified = nullptr, Strategy strategy = Strategy());
 
    /**
     * Update a given solution by performing the "2-opt*" movement.
     *
-    * @param s A solution to be updated.
-    * @return  Updated solution.
+    * @param s        A solution to be updated.
+    * @param modified If not null, only pairs of routes with at least one route in this set are explored.
+    * @param strategy Acceptance strategy.
+    * @return         Updated solution.
     */
-    Solution two_opt_star(Solution s);
+    Solution two_opt_star(Solution s, const RouteSet *modified = nullptr, Strategy strategy = Strategy());
   } // namespace details
 } // namespace algorithms
 
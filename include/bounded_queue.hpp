@@ -0,0 +1,141 @@
+/**
+ * @file   bounded_queue.hpp
+ * @author Diego Paiva
+ * @date   18/10/2026
+ *
+ * A bounded lock-free multi-producer/multi-consumer queue (Vyukov's array-based queue).
+ */
+
+#ifndef BOUNDED_QUEUE_HPP_INCLUDED
+#define BOUNDED_QUEUE_HPP_INCLUDED
+
+#include <atomic>
+#include <memory>  // std::unique_ptr
+#include <utility> // std::move
+#include <cstddef> // size_t
+#include <cstdint> // intptr_t
+
+template <typename T>
+class BoundedQueue
+{
+private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T data;
+  };
+
+  std::unique_ptr<Cell[]> buffer;
+  size_t mask;
+
+  // Keep producers and consumers positions in different cache lines
+  alignas(64) std::atomic<size_t> enqueue_pos;
+  alignas(64) std::atomic<size_t> dequeue_pos;
+
+public:
+ /**
+  * Constructor.
+  *
+  * @param capacity Minimum number of elements the queue can hold (rounded up to a power of two).
+  */
+  BoundedQueue(size_t capacity)
+  {
+    size_t size = 2;
+
+    while (size < capacity)
+      size <<= 1;
+
+    buffer.reset(new Cell[size]);
+    mask = size - 1;
+
+    for (size_t i = 0; i < size; i++)
+      buffer[i].sequence.store(i, std::memory_order_relaxed);
+
+    enqueue_pos.store(0, std::memory_order_relaxed);
+    dequeue_pos.store(0, std::memory_order_relaxed);
+  }
+
+ /**
+  * Default destructor.
+  */
+  ~BoundedQueue() {};
+
+ /**
+  * Queues should not be cloneable.
+  */
+  BoundedQueue(const BoundedQueue&) = delete;
+
+ /**
+  * Queues should not be assignable.
+  */
+  void operator=(const BoundedQueue&) = delete;
+
+ /**
+  * Try to push an element to the back of the queue.
+  *
+  * @param value Element to be pushed (moved into the queue on success).
+  * @return      `false` if the queue is full.
+  */
+  bool try_push(T &value)
+  {
+    Cell *cell;
+    size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+
+    for (;;) {
+      cell = &buffer[pos & mask];
+      size_t seq = cell->sequence.load(std::memory_order_acquire);
+      intptr_t diff = (intptr_t) seq - (intptr_t) pos;
+
+      if (diff == 0) {
+        if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          break;
+      }
+      else if (diff < 0) {
+        return false;
+      }
+      else {
+        pos = enqueue_pos.load(std::memory_order_relaxed);
+      }
+    }
+
+    cell->data = std::move(value);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+
+    return true;
+  }
+
+ /**
+  * Try to pop the element at the front of the queue.
+  *
+  * @param value Where the popped element will be moved to.
+  * @return      `false` if the queue is empty.
+  */
+  bool try_pop(T &value)
+  {
+    Cell *cell;
+    size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+
+    for (;;) {
+      cell = &buffer[pos & mask];
+      size_t seq = cell->sequence.load(std::memory_order_acquire);
+      intptr_t diff = (intptr_t) seq - (intptr_t) (pos + 1);
+
+      if (diff == 0) {
+        if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          break;
+      }
+      else if (diff < 0) {
+        return false;
+      }
+      else {
+        pos = dequeue_pos.load(std::memory_order_relaxed);
+      }
+    }
+
+    value = std::move(cell->data);
+    cell->sequence.store(pos + mask + 1, std::memory_order_release);
+
+    return true;
+  }
+};
+
+#endif // BOUNDED_QUEUE_HPP_INCLUDED
@@ -26,19 +26,23 @@ namespace gnuplot
  /**
   * Plot convergence analysis of runs.
   *
-  * @param runs   Hash map from algorithm name to runs.
-  * @param output Output file name.
+  * @param instance Instance solved by the runs, which names the data file.
+  * @param runs     Hash map from algorithm name to runs.
+  * @param output   Output file name.
   */
-  void plot_convergence_analysis(std::unordered_map<std::string, std::vector<Run>> runs, std::string output);
+  void plot_convergence_analysis(const Instance &instance, std::unordered_map<std::string, std::vector<Run>> runs,
+                                 std::string output);
 
  /**
   * Produce time-to-target plot (tttplot).
   *
-  * @param runs   Hash map from algorithm name to runs.
-  * @param target Target value.
-  * @param output Output file name.
+  * @param instance Instance solved by the runs, which names the data file.
+  * @param runs     Hash map from algorithm name to runs.
+  * @param target   Target value.
+  * @param output   Output file name.
   */
-  void tttplot(std::unordered_map<std::string, std::vector<Run>> runs, double target, std::string output);
+  void tttplot(const Instance &instance, std::unordered_map<std::string, std::vector<Run>> runs, double target,
+               std::string output);
 
   namespace details
   {
@@ -12,38 +12,102 @@
 
 #include "vehicle.hpp"
 #include "request.hpp"
+#include "travel_times.hpp"
 
 /**
- * Macro for global access.
+ * Macro for global access to the default instance, kept for programs that solve a single instance. Library code
+ * reaches its instance through the routes and solutions it works on instead.
  */
 #define inst \
         Instance::get_unique()
 
 class Instance
 {
-private:
+public:
  /**
-  * Unique Instance.
+  * Enumeration of possible layouts of the nodes in the travel times: as in the instance file, along a Hilbert
+  * curve over their coordinates or by the start of their time windows. Nodes visited one after the other tend to
+  * be close in space and time, so both orderings improve the locality of travel time lookups.
   */
-  static Instance unique;
+  enum class Ordering {FILE, HILBERT, TIME_WINDOW};
 
+private:
  /**
-  * Private constructor to prevent external instancing.
+  * Pre-processing step.
+  * Check for every pair of requests whether their time windows are compatible and store it in the compatibility matrix.
   */
-  Instance() {};
+  void init_compatibility_matrix();
 
  /**
   * Pre-processing step.
-  * Compute the distance between every pair of nodes and store it in the distance matrix.
+  * Set the index of every node in the travel times according to an ordering.
+  *
+  * @param ordering Layout of the nodes.
+  */
+  void renumber(Ordering ordering);
+
+ /**
+  * Read nodes and vehicles from an instance file.
+  *
+  * @param instance_file_name File containing instance data.
   */
-  void init_distance_matrix();
+  void parse(const std::string &instance_file_name);
+
+ /**
+  * Load the preprocessed instance from a cache file, whose matrices stay memory-mapped. Caches are discarded when
+  * their version or the size or modification time of the instance file they were built from don't match.
+  *
+  * @param instance_file_name File containing instance data.
+  * @param cache_file_name    Cache file.
+  * @param mode               Storage mode of the travel times, which must match the one of the cache, or at least
+  *                           round travel times alike, as time windows are tightened by them.
+  * @param ordering           Layout of the nodes, which must match the one of the cache.
+  * @return                   `true` if the cache was loaded.
+  */
+  bool load_cache(const std::string &instance_file_name, const std::string &cache_file_name, TravelTimes::Mode mode,
+                  Ordering ordering);
+
+ /**
+  * Write the preprocessed instance to a cache file. Failing to do so is not an error, as the cache is only an
+  * optimization.
+  *
+  * @param instance_file_name File containing instance data.
+  * @param cache_file_name    Cache file.
+  * @param ordering           Layout of the nodes.
+  */
+  void save_cache(const std::string &instance_file_name, const std::string &cache_file_name, Ordering ordering);
+
+ /**
+  * Storage of the compatibility matrix when it's computed instead of mapped from a cache.
+  */
+  std::vector<char> compatibilities;
+
+ /**
+  * Memory mapping of the cache file, if loaded.
+  */
+  const char *cache = nullptr;
+  size_t cache_size = 0;
 
 public:
   std::string name;
   std::vector<Node*> nodes;
   std::vector<Vehicle*> vehicles;
   std::vector<Request*> requests;
-  std::vector<std::vector<double>> distance_matrix;
+
+ /**
+  * Travel times between nodes, indexed by node id.
+  */
+  TravelTimes travel_times;
+
+ /**
+  * Row-major compatibility matrix indexed by pickup id - 1, or `nullptr` if compatibility is checked on demand.
+  */
+  const char *compatibility_matrix = nullptr;
+
+ /**
+  * Default constructor. Instances are independent of each other, so several of them may be solved concurrently.
+  */
+  Instance() {};
 
  /**
   * Default destructor.
@@ -61,18 +125,32 @@ public:
   void operator=(const Instance&) = delete;
 
  /**
-  * Get the instance.
+  * Get the default instance.
   *
-  * @return The unique instance.
+  * @return The default instance.
   */
   static Instance& get_unique();
 
  /**
-  * Initialize the instance with the data passed by file.
+  * Initialize the instance with the data passed by file, which is memory-mapped and parsed in place. The instance is
+  * named after the file stem. Preprocessed data (tightened time windows and matrices) is cached in a binary file
+  * next to the instance file, "<instance file>.cache", and mapped on later runs. In lazy mode travel times and
+  * compatibilities are computed on demand, so that memory stays linear in the number of nodes.
   *
-  * @param instance_file_name File containing instance data.
+  * Travel times are Euclidean distances unless a travel time file is given (see travel_times.hpp), in which case
+  * its storage mode is used and nothing is cached, as time windows are tightened by the travel times of the file.
+  * Nodes of a travel time file keep the order of the file.
+  *
+  * @param instance_file_name     File containing instance data.
+  * @param use_cache              Whether to load and write the cache file.
+  * @param mode                   Storage mode of the Euclidean travel times.
+  * @param travel_times_file_name Optional file of travel times between nodes.
+  * @param ordering               Layout of the nodes in the Euclidean travel times.
+  * @throws std::runtime_error If a file can't be read or is malformed, pointing to the offending line.
   */
-  void init(const std::string instance_file_name);
+  void init(const std::string instance_file_name, bool use_cache = true,
+            TravelTimes::Mode mode = TravelTimes::Mode::AUTO, const std::string travel_times_file_name = "",
+            Ordering ordering = Ordering::FILE);
 
  /**
   * Get depot node.
@@ -97,6 +175,16 @@ public:
   * @return   Travel time between n1 and n2.
   */
   double get_travel_time(Node *n1, Node *n2);
+
+ /**
+  * Check if two requests have compatible time windows, i.e. if their pickups may be served within one maximum
+  * ride time of each other. Only compatible requests are worth exchanging between routes.
+  *
+  * @param r1 First request.
+  * @param r2 Second request.
+  * @return   `true` if compatible.
+  */
+  bool compatible(Request *r1, Request *r2);
 };
 
 #endif // INSTANCE_HPP_INCLUDED
@@ -0,0 +1,153 @@
+/**
+ * @file   json_writer.hpp
+ * @author Diego Paiva
+ * @date   18/10/2026
+ *
+ * A streaming writer of pretty-printed JSON, which writes values straight to a file as they're produced instead
+ * of building a tree first. Nothing is kept in memory but the nesting of the open containers.
+ */
+
+#ifndef JSON_WRITER_HPP_INCLUDED
+#define JSON_WRITER_HPP_INCLUDED
+
+#include <cstdio> // FILE
+#include <string>
+#include <vector>
+
+class JsonWriter
+{
+private:
+  FILE *file;
+
+ /**
+  * Whether every open container is still empty, from the outermost to the innermost.
+  */
+  std::vector<bool> empty;
+
+ /**
+  * Whether a key was just written, so that the next value goes right after it.
+  */
+  bool after_key;
+
+ /**
+  * Write the separator and indentation preceding a new element of the innermost container.
+  */
+  void separate();
+
+ /**
+  * Write a quoted and escaped string.
+  *
+  * @param s String.
+  */
+  void write_string(const std::string &s);
+
+public:
+ /**
+  * Constructor.
+  *
+  * @param file_name Name of the output file.
+  * @throws std::runtime_error If the file can't be opened.
+  */
+  JsonWriter(const std::string &file_name);
+
+ /**
+  * Destructor. The file is closed as is, so that an interrupted document keeps everything written so far.
+  */
+  ~JsonWriter();
+
+ /**
+  * Writers should not be cloneable.
+  */
+  JsonWriter(const JsonWriter&) = delete;
+
+ /**
+  * Writers should not be assignable.
+  */
+  void operator=(const JsonWriter&) = delete;
+
+ /**
+  * Open an object.
+  *
+  * @return This writer.
+  */
+  JsonWriter& begin_object();
+
+ /**
+  * Close the innermost object.
+  *
+  * @return This writer.
+  */
+  JsonWriter& end_object();
+
+ /**
+  * Open an array.
+  *
+  * @return This writer.
+  */
+  JsonWriter& begin_array();
+
+ /**
+  * Close the innermost array.
+  *
+  * @return This writer.
+  */
+  JsonWriter& end_array();
+
+ /**
+  * Write the key of the next member of the innermost object.
+  *
+  * @param k Key.
+  * @return  This writer.
+  */
+  JsonWriter& key(const std::string &k);
+
+ /**
+  * Write a number with a fixed number of decimal places, or `null` if it isn't finite.
+  *
+  * @param v         Number.
+  * @param precision Number of decimal places.
+  * @return          This writer.
+  */
+  JsonWriter& value(double v, int precision = 2);
+
+ /**
+  * Write an integer.
+  *
+  * @param v Integer.
+  * @return  This writer.
+  */
+  JsonWriter& value(long long v);
+  JsonWriter& value(int v);
+  JsonWriter& value(unsigned int v);
+
+ /**
+  * Write a boolean.
+  *
+  * @param v Boolean.
+  * @return  This writer.
+  */
+  JsonWriter& value(bool v);
+
+ /**
+  * Write a string.
+  *
+  * @param v String.
+  * @return  This writer.
+  */
+  JsonWriter& value(const std::string &v);
+  JsonWriter& value(const char *v);
+
+ /**
+  * Write `null`.
+  *
+  * @return This writer.
+  */
+  JsonWriter& null();
+
+ /**
+  * Push everything written so far to the file.
+  */
+  void flush();
+};
+
+#endif // JSON_WRITER_HPP_INCLUDED
@@ -18,6 +18,13 @@ public:
   enum class Type {DEPOT, PICKUP, DELIVERY};
 
   int id;
+
+ /**
+  * Position of the node in the rows and columns of the travel times, equal to the id unless nodes are renumbered
+  * for locality. Ids are never changed, so solutions are always reported with the ids of the instance file.
+  */
+  int index;
+
   double latitude;
   double longitude;
   double service_time;
@@ -11,16 +11,22 @@
 
 #include "node.hpp"
 
+#include <cstddef>    // std::size_t
+#include <functional> // std::hash
+
+class Instance;
+
 class Request
 {
 private:
  /**
   * Perform time window tightening of request as stated in (Cordeau and Laporte, 2003).
   *
+  * @param instance         Instance the request belongs to.
   * @param max_ride_time    Maximum ride time.
   * @param planning_horizon Planning horizon.
   */
-  void tighten_time_windows(double max_ride_time, double planning_horizon = 1440);
+  void tighten_time_windows(Instance *instance, double max_ride_time, double planning_horizon = 1440);
 
 public:
   Node *pickup;
@@ -33,8 +39,13 @@ public:
 
  /**
   * Constructor 2.
+  *
+  * @param instance Instance the request belongs to.
+  * @param pickup   Pickup node.
+  * @param delivery Delivery node.
+  * @param tighten  Whether to tighten the time windows of the nodes, which is skipped for already tightened ones.
   */
-  Request(Node *pickup, Node *delivery);
+  Request(Instance *instance, Node *pickup, Node *delivery, bool tighten = true);
 
  /**
   * Default destructor.
@@ -42,4 +53,15 @@ public:
   ~Request() {};
 };
 
+/**
+ * Hash of requests by pickup id, for the same reason as `VehicleHash`.
+ */
+struct RequestHash
+{
+  std::size_t operator()(const Request *request) const
+  {
+    return std::hash<int>()(request->pickup->id);
+  }
+};
+
 #endif // REQUEST_HPP_INCLUDED
@@ -16,10 +16,13 @@
 #include <string>
 #include <unordered_map>
 
+class Instance;
+
 class Route
 {
 public:
   std::unordered_map<Node*, int> nodes_indices;
+  Instance *instance;
   Vehicle *vehicle;
   std::vector<Node*> path;
   std::vector<int> load;
@@ -42,9 +45,10 @@ public:
  /**
   * Constructor with vehicle.
   *
-  * @param vehicle Vehicle.
+  * @param instance Instance the route belongs to.
+  * @param vehicle  Vehicle.
   */
-  Route(Vehicle *vehicle);
+  Route(Instance *instance, Vehicle *vehicle);
 
  /**
   * Default destructor.
@@ -61,11 +65,13 @@ public:
  /**
   * Perform eight-step evaluation scheme to compute route cost and feasibility.
   *
-  * @details Updates a lot of variables of the route.
+  * @details Updates a lot of variables of the route. With `early_exit` unset, the whole schedule is computed
+  *          even after a violation is found, so that violation values are exact rather than partial.
   *
-  * @return `true` if feasible.
+  * @param early_exit Stop as soon as an irreparable violation is found.
+  * @return           `true` if feasible.
   */
-  bool evaluate();
+  bool evaluate(bool early_exit = true);
 
  /**
   * Check if route has no requests accommodated.
@@ -0,0 +1,90 @@
+/**
+ * @file   route_pool.hpp
+ * @author Diego Paiva
+ * @date   18/10/2026
+ *
+ * A bounded and thread-safe pool of routes, deduplicated by the set of requests they serve, from which
+ * new solutions are assembled by a greedy set-partitioning heuristic.
+ */
+
+#ifndef ROUTE_POOL_HPP_INCLUDED
+#define ROUTE_POOL_HPP_INCLUDED
+
+#include "solution.hpp"
+
+#include <mutex>  // std::mutex
+#include <atomic> // std::atomic
+#include <map>    // std::map
+
+class RoutePool
+{
+private:
+ /**
+  * A route along with the (sorted) indices of the requests it serves.
+  */
+  struct Entry
+  {
+    Route route;
+    std::vector<int> requests;
+  };
+
+  Instance *instance;
+  std::map<std::vector<int>, Entry> entries;
+  std::mutex mutex;
+  int capacity;
+
+public:
+ /**
+  * Number of successful additions so far, so that consumers can tell whether the pool changed.
+  */
+  std::atomic<int> version;
+
+ /**
+  * Constructor.
+  *
+  * @param instance Instance the routes belong to.
+  * @param capacity Maximum number of routes in the pool.
+  */
+  RoutePool(Instance &instance, int capacity);
+
+ /**
+  * Default destructor.
+  */
+  ~RoutePool() {};
+
+ /**
+  * Add a feasible route to the pool. Among routes serving the same requests only the cheapest one is kept
+  * and, once the pool is full, the route with the highest cost per request is dropped.
+  *
+  * @param r A feasible route.
+  * @return  `true` if the pool changed.
+  */
+  bool add(const Route &r);
+
+ /**
+  * Add all non-empty routes of a feasible solution to the pool.
+  *
+  * @param s A feasible solution.
+  */
+  void add(const Solution &s);
+
+ /**
+  * Get the number of routes in the pool.
+  *
+  * @return Size of the pool.
+  */
+  int size();
+
+ /**
+  * Assemble a solution from routes of the pool: routes are picked greedily by cost per request among those
+  * not sharing requests with the picked ones, and uncovered requests are inserted at their cheapest positions.
+  * The first attempt is purely greedy, the following ones randomly perturb the costs per request.
+  *
+  * @param attempts Number of greedy attempts.
+  * @param noise    Maximum relative perturbation of the costs per request.
+  * @return         Best solution assembled, with infinite cost if every attempt failed.
+  */
+  Solution recombine(int attempts = 10, double noise = 0.1);
+};
+
+#endif // ROUTE_POOL_HPP_INCLUDED
@@ -13,19 +13,39 @@
 
 #include <map>
 
+/**
+ * Statistics of a single randomness parameter (alpha) of the Reactive GRASP.
+ */
+struct AlphaStats
+{
+  double probability;
+  double sum;
+  int count;
+
+ /**
+  * Average cost of the feasible solutions obtained with the alpha.
+  *
+  * @return Average cost (zero if the alpha was never used).
+  */
+  double avg() const { return count > 0 ? sum/count : 0.0; }
+};
+
 class Run
 {
 public:
   Solution init;
   Solution best;
   double elapsed_seconds;
+  int best_iteration;
+  double best_alpha;
+  std::map<double, AlphaStats> alphas;
   std::vector<unsigned int> seeds;
   std::vector<std::pair<double, double>> convergence;
 
  /**
   * Default constructor.
   */
-  Run() {};
+  Run() : best_iteration(0), best_alpha(0.0) {};
 
  /**
   * Default destructor.
@@ -17,7 +17,12 @@ public:
  /*
   * Hash map to assign each vehicle to a particular route.
   */
-  std::unordered_map<Vehicle*, Route> routes;
+  std::unordered_map<Vehicle*, Route, VehicleHash> routes;
+
+ /*
+  * Instance the solution belongs to, taken from its first route unless given.
+  */
+  Instance *instance;
 
  /*
   * Solution's total cost.
@@ -33,8 +38,10 @@ public:
 
  /**
   * Default constructor.
+  *
+  * @param instance Instance the solution belongs to.
   */
-  Solution();
+  Solution(Instance *instance = nullptr);
 
  /**
   * Default destructor.
@@ -46,7 +53,7 @@ public:
   *
   * @return `true` if feasible.
   */
-  bool feasible();
+  bool feasible() const;
 
  /**
   * Delete routes without requests accomodated.
@@ -0,0 +1,296 @@
+/**
+ * @file   travel_times.hpp
+ * @author Diego Paiva
+ * @date   18/10/2026
+ *
+ * Travel times between the nodes of an instance, either stored in a dense matrix or computed on demand from
+ * the coordinates of the nodes, in which case memory stays linear in the number of nodes. Travel times may also
+ * be read from a memory-mapped binary file, e.g. with road-network times, which need not be symmetric. Rows and
+ * columns follow `Node::index`, so that nodes may be laid out in memory independently of their ids.
+ *
+ * Travel time files are native-endian and made of a 40-byte header:
+ *
+ *   char     magic[8]      "DARPTTM\0"
+ *   uint32_t version       1
+ *   uint32_t byte_order    0x01020304
+ *   uint32_t format        0 for a dense matrix, 1 for a sparse (CSR) matrix
+ *   int32_t  nodes         number of nodes n, including the depot
+ *   uint64_t entries       number of stored travel times, n * n if dense
+ *   double   default_time  travel time of the pairs missing from a sparse matrix
+ *
+ * followed, if dense, by the n * n row-major travel times (double) or, if sparse, by n + 1 row offsets
+ * (uint64_t), the column of every entry (int32_t, strictly increasing within a row, padded with 4 bytes if
+ * `entries` is odd) and the travel time of every entry (double). Rows and columns are node ids. The travel time
+ * from a node to itself is 0 when missing from a sparse matrix.
+ *
+ * Symmetric travel times may be stored compactly, so that the matrix of larger instances fits in cache: a packed
+ * lower triangle of doubles, a matrix of floats or a matrix of 16-bit integers scaled by the largest travel time.
+ * Floats and integers are rounded up, so travel times are never underestimated.
+ */
+
+#ifndef TRAVEL_TIMES_HPP_INCLUDED
+#define TRAVEL_TIMES_HPP_INCLUDED
+
+#include <vector>
+#include <string>
+#include <cstdint>   // uint64_t, int32_t, uint16_t
+#include <cmath>     // sqrt
+#include <algorithm> // std::min, std::max
+
+#include "node.hpp"
+
+class TravelTimes
+{
+public:
+ /**
+  * Enumeration of possible storage modes. `AUTO` picks the dense mode unless the matrix would be too large.
+  */
+  enum class Mode {AUTO, DENSE, LAZY, SPARSE, TRIANGULAR, FLOAT32, QUANTIZED};
+
+ /**
+  * Largest number of nodes for which `AUTO` picks the dense mode (a 800 MB matrix).
+  */
+  static const int max_dense_nodes = 10000;
+
+private:
+  Mode mode;
+  int n;
+
+ /**
+  * Coordinates of the nodes by index, stored apart so that rows are computed with vector instructions.
+  */
+  std::vector<double> latitudes;
+  std::vector<double> longitudes;
+  const double *x;
+  const double *y;
+
+ /**
+  * Storage of the matrix when it's computed instead of mapped from a cache.
+  */
+  std::vector<double> storage;
+  const double *matrix;
+
+ /**
+  * Compact storage of symmetric travel times: packed lower triangle, floats and scaled 16-bit integers.
+  */
+  std::vector<double> triangle;
+  std::vector<float> floats;
+  std::vector<uint16_t> quantized;
+  double scale;
+
+ /**
+  * Sparse matrix in CSR format, rows and columns indexed by node index.
+  */
+  const uint64_t *offsets;
+  const int32_t *columns;
+  const double *values;
+  double default_time;
+
+ /**
+  * Memory mapping of the travel time file, if loaded.
+  */
+  const char *mapping;
+  size_t mapping_size;
+
+ /**
+  * Number of rows kept by the cache of every thread unless dense.
+  */
+  int cache_rows;
+
+ /**
+  * Unique identifier, so that thread-local caches can tell which provider their rows belong to.
+  */
+  unsigned long long uid;
+
+public:
+ /**
+  * Constructor.
+  */
+  TravelTimes();
+
+ /**
+  * Destructor.
+  */
+  ~TravelTimes();
+
+ /**
+  * Providers should not be cloneable.
+  */
+  TravelTimes(const TravelTimes&) = delete;
+
+ /**
+  * Providers should not be assignable.
+  */
+  void operator=(const TravelTimes&) = delete;
+
+ /**
+  * Initialize the provider with the Euclidean distances between nodes.
+  *
+  * @param nodes      Nodes of the instance.
+  * @param mode       Storage mode, `AUTO` is resolved by the number of nodes.
+  * @param cache_rows Number of rows cached by every thread unless dense.
+  * @throws std::invalid_argument If the mode is `SPARSE`, which is only available through `load`.
+  */
+  void init(const std::vector<Node*> &nodes, Mode mode = Mode::AUTO, int cache_rows = 32);
+
+ /**
+  * Initialize the provider in dense mode over a matrix owned by someone else, e.g. a memory-mapped cache.
+  *
+  * @param nodes  Nodes of the instance.
+  * @param matrix Row-major matrix of travel times, which must outlive the provider.
+  */
+  void init(const std::vector<Node*> &nodes, const double *matrix);
+
+ /**
+  * Initialize the provider with the travel times of a file, which stays memory-mapped.
+  *
+  * @param nodes     Nodes of the instance, whose indices must match the rows of the file.
+  * @param file_name Travel time file.
+  * @throws std::runtime_error If the file can't be read, is malformed or doesn't match the number of nodes.
+  */
+  void load(const std::vector<Node*> &nodes, const std::string &file_name);
+
+ /**
+  * Get the storage mode, never `AUTO` once initialized.
+  *
+  * @return Storage mode.
+  */
+  Mode get_mode() const;
+
+ /**
+  * Check whether travel times are stored in a matrix, dense or compact, rather than computed on demand or sparse.
+  *
+  * @return `true` if stored in a matrix.
+  */
+  bool is_stored() const;
+
+ /**
+  * Check whether travel times are Euclidean distances, rounded or not, rather than loaded from a file. Only then
+  * are they known to satisfy the triangle inequality (up to the last bit of floats in `FLOAT32` mode), so that
+  * inserting a node never decreases the travel cost.
+  *
+  * @return `true` if Euclidean.
+  */
+  bool is_euclidean() const;
+
+ /**
+  * Check whether stored travel times are rounded up, i.e. in `FLOAT32` or `QUANTIZED` mode.
+  *
+  * @return `true` if rounded.
+  */
+  bool is_rounded() const;
+
+ /**
+  * Get the memory used by the stored travel times, excluding memory-mapped files and row caches.
+  *
+  * @return Size in bytes.
+  */
+  size_t get_size() const;
+
+ /**
+  * Get the memory used by the row cache of every thread asking for rows, which is only allocated unless dense.
+  *
+  * @return Size in bytes per thread.
+  */
+  size_t get_cache_size() const;
+
+ /**
+  * Get the dense matrix.
+  *
+  * @return Row-major matrix of travel times, or `nullptr` in lazy mode.
+  */
+  const double* data() const;
+
+ /**
+  * Get the travel time between two nodes.
+  *
+  * @param i Index of the first node.
+  * @param j Index of the second node.
+  * @return  Travel time from i to j.
+  */
+  double get(int i, int j) const
+  {
+    switch (mode) {
+      case Mode::DENSE:
+        return matrix[(size_t) i * n + j];
+
+      case Mode::TRIANGULAR: {
+        // Branchless, as the order of the nodes is unpredictable
+        size_t row = std::max(i, j), column = std::min(i, j);
+        return triangle[row * (row + 1)/2 + column];
+      }
+
+      case Mode::FLOAT32:
+        return floats[(size_t) i * n + j];
+
+      case Mode::QUANTIZED:
+        return quantized[(size_t) i * n + j] * scale;
+
+      case Mode::SPARSE:
+        return get_sparse(i, j);
+
+      default:
+        double dx = x[i] - x[j], dy = y[i] - y[j];
+        return sqrt(dx * dx + dy * dy);
+    }
+  }
+
+ /**
+  * Get the Euclidean distance between two nodes, computed from their coordinates whatever the storage mode, e.g.
+  * to cost solutions found with rounded travel times. Meaningless for travel times loaded from a file.
+  *
+  * @param i Index of the first node.
+  * @param j Index of the second node.
+  * @return  Distance between i and j.
+  */
+  double get_exact(int i, int j) const
+  {
+    double dx = x[i] - x[j], dy = y[i] - y[j];
+    return sqrt(dx * dx + dy * dy);
+  }
+
+ /**
+  * Get the travel time between two nodes of a sparse matrix by binary search within the row.
+  *
+  * @param i Index of the first node.
+  * @param j Index of the second node.
+  * @return  Travel time from i to j.
+  */
+  double get_sparse(int i, int j) const
+  {
+    const int32_t *first = columns + offsets[i], *last = columns + offsets[i + 1];
+
+    while (first < last) {
+      const int32_t *middle = first + (last - first)/2;
+
+      if (*middle < j)
+        first = middle + 1;
+      else
+        last = middle;
+    }
+
+    if (first != columns + offsets[i + 1] && *first == j)
+      return values[first - columns];
+
+    return i == j ? 0.0 : default_time;
+  }
+
+ /**
+  * Get the travel times from a node to every node. Unless dense, rows are computed into a bounded cache of the
+  * calling thread, where a row stays valid until the thread asks for `cache_rows` other rows.
+  *
+  * @param i Index of the node.
+  * @return  Travel times from i, indexed by node index.
+  */
+  const double* row(int i) const;
+
+ /**
+  * Compute the travel times from a node to every node.
+  *
+  * @param i   Index of the node.
+  * @param out Array of as many elements as nodes.
+  */
+  void fill_row(int i, double *out) const;
+};
+
+#endif // TRAVEL_TIMES_HPP_INCLUDED
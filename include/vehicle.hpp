@@ -9,6 +9,9 @@
 #ifndef VEHICLE_HPP_INCLUDED
 #define VEHICLE_HPP_INCLUDED
 
+#include <cstddef>    // std::size_t
+#include <functional> // std::hash
+
 class Vehicle
 {
 public:
@@ -36,4 +39,16 @@ public:
   ~Vehicle() {};
 };
 
+/**
+ * Hash of vehicles by id, so that the order of hash containers of vehicles doesn't depend on where the vehicles
+ * were allocated, which would make seeded runs irreproducible.
+ */
+struct VehicleHash
+{
+  std::size_t operator()(const Vehicle *vehicle) const
+  {
+    return std::hash<int>()(vehicle->id);
+  }
+};
+
 #endif // VEHICLE_HPP_INCLUDED
@@ -2,23 +2,23 @@
 
 cd build && make
 
-# ./darp.exe ../data/instances/R1a.txt 10 8 R1a-GRASP.json
-# ./darp.exe ../data/instances/R2a.txt 10 8 R2a-GRASP.json
-# ./darp.exe ../data/instances/R3a.txt 10 8 R3a-GRASP.json
-# ./darp.exe ../data/instances/R4a.txt 10 8 R4a-GRASP.json
-# ./darp.exe ../data/instances/R5a.txt 10 8 R5a-GRASP.json
-# ./darp.exe ../data/instances/R6a.txt 10 8 R6a-GRASP.json
-# ./darp.exe ../data/instances/R7a.txt 10 8 R7a-GRASP.json
-# ./darp.exe ../data/instances/R8a.txt 10 8 R8a-GRASP.json
-# ./darp.exe ../data/instances/R9a.txt 10 8 R9a-GRASP.json
-# ./darp.exe ../data/instances/R10a.txt 10 8 R10a-ILS.json
-# ./darp.exe ../data/instances/R1b.txt 10 8 R1b-ILS.json
-# ./darp.exe ../data/instances/R2b.txt 10 8 R2b-ILS.json
-# ./darp.exe ../data/instances/R3b.txt 10 8 R3b-ILS.json
-# ./darp.exe ../data/instances/R4b.txt 10 8 R4b-ILS.json
-# ./darp.exe ../data/instances/R5b.txt 10 8 R5b-ILS.json
-# ./darp.exe ../data/instances/R6b.txt 10 8 R6b-GRASP.json
-# ./darp.exe ../data/instances/R7b.txt 10 8 R7b-GRASP.json
-# ./darp.exe ../data/instances/R8b.txt 10 8 R8b-GRASP.json
-# ./darp.exe ../data/instances/R9b.txt 10 8 R9b-ILS.json
-# ./darp.exe ../data/instances/R10b.txt 10 8 R10b-GRASP.json
+# ./darp.exe -e grasp -r 10 -t 8 -o R1a-GRASP.json ../data/instances/R1a.txt
+# ./darp.exe -e grasp -r 10 -t 8 -o R2a-GRASP.json ../data/instances/R2a.txt
+# ./darp.exe -e grasp -r 10 -t 8 -o R3a-GRASP.json ../data/instances/R3a.txt
+# ./darp.exe -e grasp -r 10 -t 8 -o R4a-GRASP.json ../data/instances/R4a.txt
+# ./darp.exe -e grasp -r 10 -t 8 -o R5a-GRASP.json ../data/instances/R5a.txt
+# ./darp.exe -e grasp -r 10 -t 8 -o R6a-GRASP.json ../data/instances/R6a.txt
+# ./darp.exe -e grasp -r 10 -t 8 -o R7a-GRASP.json ../data/instances/R7a.txt
+# ./darp.exe -e grasp -r 10 -t 8 -o R8a-GRASP.json ../data/instances/R8a.txt
+# ./darp.exe -e grasp -r 10 -t 8 -o R9a-GRASP.json ../data/instances/R9a.txt
+# ./darp.exe -e ils -r 10 -t 8 -o R10a-ILS.json ../data/instances/R10a.txt
+# ./darp.exe -e ils -r 10 -t 8 -o R1b-ILS.json ../data/instances/R1b.txt
+# ./darp.exe -e ils -r 10 -t 8 -o R2b-ILS.json ../data/instances/R2b.txt
+# ./darp.exe -e ils -r 10 -t 8 -o R3b-ILS.json ../data/instances/R3b.txt
+# ./darp.exe -e ils -r 10 -t 8 -o R4b-ILS.json ../data/instances/R4b.txt
+# ./darp.exe -e ils -r 10 -t 8 -o R5b-ILS.json ../data/instances/R5b.txt
+# ./darp.exe -e grasp -r 10 -t 8 -o R6b-GRASP.json ../data/instances/R6b.txt
+# ./darp.exe -e grasp -r 10 -t 8 -o R7b-GRASP.json ../data/instances/R7b.txt
+# ./darp.exe -e grasp -r 10 -t 8 -o R8b-GRASP.json ../data/instances/R8b.txt
+# ./darp.exe -e ils -r 10 -t 8 -o R9b-ILS.json ../data/instances/R9b.txt
+# ./darp.exe -e grasp -r 10 -t 8 -o R10b-GRASP.json ../data/instances/R10b.txt
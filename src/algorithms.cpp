@@ -7,15 +7,44 @@
 #include "algorithms.hpp"
 #include "instance.hpp"
 #include "gnuplot.hpp"
-
-#include <cfloat> // FLT_MAX
-#include <omp.h>  // OpenMP
+#include "bounded_queue.hpp"
+#include "route_pool.hpp"
+
+#include <cfloat>        // FLT_MAX
+#include <algorithm>     // std::sort, std::remove_if
+#include <atomic>        // std::atomic
+#include <unordered_set> // std::unordered_set
+#include <thread>        // std::thread, std::this_thread
+#include <chrono>        // std::chrono
+#include <numeric>       // std::accumulate
+#include <cmath>         // pow
+#include <tuple>         // std::tuple
+#include <map>           // std::map
+#include <omp.h>         // OpenMP
 
 namespace algorithms
 {
   using namespace details;
 
-  Run grasp(int iterations, double random_param, int thread_count)
+  // Seed of the runs started by every thread, so that concurrent runs of a batch are seeded independently
+  static thread_local bool seed_set = false;
+  static thread_local unsigned int seed_value = 0;
+
+  // Time limit of the following runs
+  static double time_limit = 0.0;
+
+  void set_seed(unsigned int seed)
+  {
+    seed_value = seed;
+    seed_set = true;
+  }
+
+  void set_time_limit(double seconds)
+  {
+    time_limit = seconds;
+  }
+
+  Run grasp(Instance &instance, int iterations, double random_param, int thread_count, int regret_k, int pool_capacity)
   {
     if (thread_count < 1 || thread_count > omp_get_max_threads())
       thread_count = omp_get_max_threads();
@@ -24,33 +53,330 @@ namespace algorithms
     run.best.cost = FLT_MAX;
 
     double start = omp_get_wtime();
+    double deadline = get_deadline(start);
+
+    // Locally optimal routes of every thread feed a pool, which is recombined by another thread meanwhile
+    RoutePool pool(instance, std::max(pool_capacity, 1));
+    Solution recombined;
+    recombined.cost = FLT_MAX;
+
+    std::atomic<bool> searching(true);
+    std::thread recombiner;
+
+    // Threads are seeded by their number, so that seeded runs don't depend on the order they start
+    unsigned int first_seed = get_seed();
+
+    if (pool_capacity > 0) {
+      recombiner = std::thread([&] {
+        Random::seed(first_seed + thread_count);
+
+        // Outside of the team, parallel regions of the recombination would start teams of every core of their own
+        omp_set_num_threads(1);
+
+        for (int version = 0; searching; ) {
+          // Nothing new to recombine
+          if (pool.version == version) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            continue;
+          }
+
+          version = pool.version;
+          Solution s = pool.recombine();
+
+          if (s.cost < FLT_MAX) {
+            s = vnd(s, false, Strategy(), deadline);
+            pool.add(s);
+
+            if (s.cost < recombined.cost)
+              recombined = s;
+          }
+        }
+      });
+    }
 
     #pragma omp parallel num_threads(thread_count)
     {
-      // Use std::random_device to generate seed to Random engine to each thread
-      unsigned int seed = std::random_device{}();
+      unsigned int seed = first_seed + omp_get_thread_num();
       Random::seed(seed);
 
       #pragma omp critical
       run.seeds.push_back(seed);
 
+      // Constructions of every thread are completed until one of them is feasible, so that the run has a solution
+      bool first = true;
+
       #pragma omp for
       for (int it = 1; it <= iterations; it++) {
-        Solution init = construct_greedy_randomized_solution(random_param);
+        // Iterations of a worksharing loop can't break, the remaining ones are skipped instead
+        if (!first && out_of_time(start))
+          continue;
+
+        Solution init = construct_greedy_randomized_solution(instance, random_param, regret_k, first ? DBL_MAX : deadline);
+
+        // Abandoned at the deadline
+        if (init.cost == FLT_MAX)
+          continue;
 
         if (!init.feasible())
           init = repair(init);
 
-        Solution curr = vnd(init);
+        Solution curr = vnd(init, false, Strategy(), deadline);
+        first = first && !curr.feasible();
+
+        if (pool_capacity > 0 && curr.feasible())
+          pool.add(curr);
+
+        #pragma omp critical
+        if (curr.feasible() && curr.cost < run.best.cost) {
+          run.best = curr;
+          run.init = init;
+        }
+      }
+    }
+
+    if (pool_capacity > 0) {
+      searching = false;
+      recombiner.join();
+
+      // Last recombination over the complete pool, unless out of time
+      if (!out_of_time(start)) {
+        Solution s = pool.recombine();
+
+        if (s.cost < FLT_MAX && (s = vnd(s, false, Strategy(), deadline)).cost < recombined.cost)
+          recombined = s;
+      }
+
+      if (recombined.cost < run.best.cost)
+        run.best = recombined;
+    }
+
+    // Threads push their seeds in any order
+    std::sort(run.seeds.begin(), run.seeds.end());
+
+    run.best.delete_empty_routes();
+    run.init.delete_empty_routes();
+
+    double finish = omp_get_wtime();
+    run.elapsed_seconds = finish - start;
+
+    return run;
+  }
+
+  Run pipelined_grasp(Instance &instance, int iterations, double random_param, int constructor_count,
+                      int local_search_count, double dominance_tolerance, int regret_k)
+  {
+    int thread_count = std::max(1, constructor_count) + std::max(0, local_search_count);
+
+    Run run;
+    run.best.cost = FLT_MAX;
+
+    BoundedQueue<Solution> starts(2 * thread_count);
+    std::unordered_set<std::string> keys;
+    double best_start_cost = FLT_MAX;
+
+    std::atomic<int> constructed(0);
+    std::atomic<int> working_constructors(0);
+
+    double start = omp_get_wtime();
+    double deadline = get_deadline(start);
+    unsigned int first_seed = get_seed();
+
+    #pragma omp parallel num_threads(thread_count)
+    {
+      unsigned int seed = first_seed + omp_get_thread_num();
+      Random::seed(seed);
+
+      #pragma omp critical
+      run.seeds.push_back(seed);
+
+      // The team may be smaller than requested, so there must always be at least one constructor
+      bool constructor = omp_get_thread_num() < std::min(std::max(1, constructor_count), omp_get_num_threads());
+
+      if (constructor)
+        working_constructors++;
+
+      #pragma omp barrier
+
+      // Consume a single start from the queue, returning `false` if there was none available
+      auto consume = [&] () -> bool {
+        Solution init;
+
+        if (!starts.try_pop(init))
+          return false;
+
+        // Starts left in the queue at the deadline are only compared
+        Solution curr = vnd(init, false, Strategy(), deadline);
 
         #pragma omp critical
         if (curr.feasible() && curr.cost < run.best.cost) {
           run.best = curr;
           run.init = init;
         }
+
+        return true;
+      };
+
+      if (constructor) {
+        // Constructions are completed until a start is queued, so that the run has a solution
+        for (bool first = true; constructed++ < iterations && (first || !out_of_time(start)); ) {
+          Solution init = construct_greedy_randomized_solution(
+            instance, random_param, regret_k, first ? DBL_MAX : deadline
+          );
+
+          // Abandoned at the deadline
+          if (init.cost == FLT_MAX)
+            continue;
+
+          if (!init.feasible())
+            init = repair(init);
+
+          // Infeasible starts are discarded by VND anyway
+          if (!init.feasible())
+            continue;
+
+          bool accepted;
+
+          #pragma omp critical(start_filter)
+          {
+            accepted = init.cost <= (1 + dominance_tolerance) * best_start_cost && keys.insert(init.to_key()).second;
+            best_start_cost = std::min(best_start_cost, init.cost);
+          }
+
+          if (!accepted)
+            continue;
+
+          first = false;
+
+          // Help local search threads instead of spinning while the queue is full
+          while (!starts.try_push(init))
+            consume();
+        }
+
+        working_constructors--;
+      }
+
+      while (working_constructors > 0)
+        if (!consume())
+          std::this_thread::yield();
+
+      // Drain whatever was left in the queue after the last constructor finished
+      while (consume())
+        ;
+    }
+
+    // Threads push their seeds in any order
+    std::sort(run.seeds.begin(), run.seeds.end());
+
+    run.best.delete_empty_routes();
+    run.init.delete_empty_routes();
+
+    double finish = omp_get_wtime();
+    run.elapsed_seconds = finish - start;
+
+    return run;
+  }
+
+  Run reactive_grasp(Instance &instance, int iterations, int block_size, std::vector<double> alphas, int thread_count,
+                     double amplification, int regret_k)
+  {
+    if (thread_count < 1 || thread_count > omp_get_max_threads())
+      thread_count = omp_get_max_threads();
+
+    // Blocks of no iterations would never end
+    block_size = std::max(block_size, 1);
+
+    Run run;
+    run.best.cost = FLT_MAX;
+
+    // Every alpha starts with the same probability
+    for (double alpha : alphas)
+      run.alphas[alpha] = {1.0/alphas.size(), 0.0, 0};
+
+    std::vector<double> probabilities(alphas.size(), 1.0/alphas.size());
+
+    double start = omp_get_wtime();
+    double deadline = get_deadline(start);
+    bool stopped = false;
+    unsigned int first_seed = get_seed();
+
+    #pragma omp parallel num_threads(thread_count)
+    {
+      unsigned int seed = first_seed + omp_get_thread_num();
+      Random::seed(seed);
+
+      #pragma omp critical
+      run.seeds.push_back(seed);
+
+      // Constructions of every thread are completed until one of them is feasible, so that the run has a solution
+      bool first = true;
+
+      for (int block = 0; block * block_size < iterations && !stopped; block++) {
+        #pragma omp for schedule(dynamic)
+        for (int it = block * block_size + 1; it <= std::min(iterations, (block + 1) * block_size); it++) {
+          if (!first && out_of_time(start))
+            continue;
+
+          std::discrete_distribution<int> distribution(probabilities.begin(), probabilities.end());
+          double alpha = alphas[Random::get(distribution)];
+
+          Solution init = construct_greedy_randomized_solution(instance, alpha, regret_k, first ? DBL_MAX : deadline);
+
+          // Abandoned at the deadline
+          if (init.cost == FLT_MAX)
+            continue;
+
+          if (!init.feasible())
+            init = repair(init);
+
+          Solution curr = vnd(init, false, Strategy(), deadline);
+          first = first && !curr.feasible();
+
+          #pragma omp critical
+          if (curr.feasible()) {
+            run.alphas[alpha].sum += curr.cost;
+            run.alphas[alpha].count++;
+
+            if (curr.cost < run.best.cost) {
+              run.best = curr;
+              run.init = init;
+              run.best_iteration = it;
+              run.best_alpha = alpha;
+            }
+          }
+        }
+
+        // Alphas yielding better average solutions get proportionally more iterations in the next block
+        #pragma omp single
+        {
+          // Decided by a single thread, so that the whole team leaves the loop at the same block
+          stopped = out_of_time(start);
+
+          std::vector<double> q(alphas.size(), 0.0);
+
+          for (int i = 0; i < (int) alphas.size(); i++)
+            if (run.alphas[alphas[i]].count > 0)
+              q[i] = pow(run.best.cost/run.alphas[alphas[i]].avg(), amplification);
+
+          // Alphas never evaluated keep the largest score so they are still explored
+          double max_q = *std::max_element(q.begin(), q.end());
+
+          for (int i = 0; i < (int) alphas.size(); i++)
+            if (run.alphas[alphas[i]].count == 0)
+              q[i] = max_q > 0.0 ? max_q : 1.0;
+
+          double sum = std::accumulate(q.begin(), q.end(), 0.0);
+
+          for (int i = 0; i < (int) alphas.size(); i++) {
+            probabilities[i] = q[i]/sum;
+            run.alphas[alphas[i]].probability = probabilities[i];
+          }
+        }
       }
     }
 
+    // Threads push their seeds in any order
+    std::sort(run.seeds.begin(), run.seeds.end());
+
     run.best.delete_empty_routes();
     run.init.delete_empty_routes();
 
@@ -60,31 +386,36 @@ namespace algorithms
     return run;
   }
 
-  Run ils(int max_iterations, int no_improvement_iterations, double random_param)
+  Run ils(Instance &instance, int max_iterations, int no_improvement_iterations, double random_param, int regret_k,
+          Strategy strategy)
   {
     Run run;
     double start = omp_get_wtime();
 
-    // Use std::random_device to generate seed to Random engine to each thread
-    unsigned int seed = std::random_device{}();
+    // Seed the Random engine of each thread, from std::random_device unless a seed was set
+    unsigned int seed = get_seed();
     Random::seed(seed);
     run.seeds.push_back(seed);
 
     do {
-      run.init = construct_greedy_randomized_solution(random_param);
+      run.init = construct_greedy_randomized_solution(instance, random_param, regret_k);
 
       if (!run.init.feasible())
         run.init = repair(run.init);
     }
     while (!run.init.feasible());
 
-    run.best = vnd(run.init);
+    double deadline = get_deadline(start);
 
-    for (int it = 0, n = 0; it <= max_iterations; it++, n++) {
-      Solution s = vnd(perturb(run.best));
+    run.best = vnd(run.init, false, strategy, deadline);
+    run.convergence.push_back({omp_get_wtime() - start, run.best.cost});
+
+    for (int it = 0, n = 0; it <= max_iterations && !out_of_time(start); it++, n++) {
+      Solution s = vnd(perturb(run.best), false, strategy, deadline);
 
       if (s.feasible() && s.cost < run.best.cost) {
         run.best = s;
+        run.convergence.push_back({omp_get_wtime() - start, run.best.cost});
         n = 0;
       }
       else {
@@ -98,228 +429,890 @@ namespace algorithms
     run.init.delete_empty_routes();
     run.best.delete_empty_routes();
 
-    double finish = omp_get_wtime();
-    run.elapsed_seconds = finish - start;
+    double finish = omp_get_wtime();
+    run.elapsed_seconds = finish - start;
+
+    return run;
+  }
+
+  namespace details
+  {
+    unsigned int get_seed()
+    {
+      return seed_set ? seed_value : std::random_device{}();
+    }
+
+    double get_deadline(double start)
+    {
+      return time_limit > 0.0 ? start + time_limit : DBL_MAX;
+    }
+
+    bool out_of_time(double start)
+    {
+      return time_limit > 0.0 && omp_get_wtime() - start >= time_limit;
+    }
+
+    Solution construct_greedy_randomized_solution(Instance &instance, double random_param, int regret_k,
+                                                  double deadline)
+    {
+      Solution solution(&instance);
+
+      for (Vehicle *v : instance.vehicles) {
+        Route r = Route(&instance, v);
+        r.path.push_back(instance.get_depot());
+        r.path.push_back(instance.get_depot());
+        solution.add_route(r);
+      }
+
+      // New vehicles are allowed, so insertions only fail at the deadline
+      if (!insert_requests(solution, instance.requests, random_param, regret_k, true, deadline))
+        solution.cost = FLT_MAX;
+
+      return solution;
+    }
+
+    bool insert_requests(Solution &solution, std::vector<Request*> requests, double random_param, int regret_k,
+                         bool allow_new_vehicles, double deadline)
+    {
+      Instance &instance = *solution.instance;
+
+      struct Candidate {
+        Route route;
+        Request *request;
+        double regret;
+
+        // Cheapest insertion of the request in every route, only the modified route needs to be updated
+        std::unordered_map<Vehicle*, Route, VehicleHash> insertions;
+
+        void update_route(const Solution &s, int k)
+        {
+          std::vector<std::pair<double, Vehicle*>> deltas;
+
+          for (auto &pair : insertions)
+            if (pair.second.feasible())
+              deltas.push_back({pair.second.cost - s.routes.at(pair.first).cost, pair.first});
+
+          int size = std::min((int) deltas.size(), std::max(1, k));
+          std::partial_sort(deltas.begin(), deltas.begin() + size, deltas.end());
+
+          route.cost = FLT_MAX;
+
+          if (!deltas.empty())
+            route = insertions[deltas[0].second];
+
+          // Routes missing among the k best count as a huge regret, so requests with few options go first
+          regret = 0.0;
+
+          for (int i = 1; i < k; i++)
+            regret += i < (int) deltas.size() ? deltas[i].first - deltas[0].first : FLT_MAX;
+        }
+      };
+
+      std::vector<Candidate> candidates(requests.size());
+
+      /* Candidates are evaluated by a team of their own only when called outside of a parallel region, where a
+       * nested team would be serialized anyway, and when there are enough of them to pay for the fork and join.
+       */
+      const int min_parallel_candidates = 16;
+      const bool parallel = !omp_in_parallel();
+
+      // Init candidates
+      #pragma omp parallel for schedule(dynamic) if(parallel && candidates.size() >= min_parallel_candidates)
+      for (int i = 0; i < (int) candidates.size(); i++) {
+        candidates[i].request = requests[i];
+
+        for (auto &pair : solution.routes)
+          candidates[i].insertions[pair.first] = get_cheapest_insertion(requests[i], pair.second);
+
+        candidates[i].update_route(solution, regret_k);
+      }
+
+      auto cmp = [regret_k] (const Candidate &c1, const Candidate &c2) {
+        if (regret_k > 1 && c1.regret != c2.regret)
+          return c1.regret > c2.regret;
+
+        return c1.route.cost < c2.route.cost;
+      };
+
+      while (!candidates.empty()) {
+        if (omp_get_wtime() >= deadline)
+          return false;
+
+        // Inserting requests never turns an infeasible insertion feasible, so fail as early as possible
+        if (!allow_new_vehicles)
+          for (Candidate &c : candidates)
+            if (!c.route.feasible())
+              return false;
+
+        // Only the restricted candidate list must be ordered before the pick, which is a linear-time selection
+        int rcl_size = std::max(1, (int) (random_param * candidates.size()));
+        std::nth_element(candidates.begin(), candidates.begin() + rcl_size - 1, candidates.end(), cmp);
+
+        auto chosen_candidate = Random::get(candidates.begin(), candidates.begin() + rcl_size);
+        RouteSet modified;
+
+        if (chosen_candidate->route.feasible()) {
+          modified.insert(chosen_candidate->route.vehicle);
+          solution.add_route(chosen_candidate->route);
+        }
+        else if (insert_with_ejections(solution, chosen_candidate->request, &modified)) {
+          // Request inserted by ejecting others, every route of the chain was modified
+        }
+        else {
+          // Activate new vehicle to accomodate the request (thus solution will be infeasible)
+          Vehicle *v = new Vehicle(solution.routes.size() + 1, instance.vehicles[0]->capacity, instance.vehicles[0]->max_route_duration);
+          Route r(&instance, v);
+
+          r.path.push_back(instance.get_depot());
+          r.path.push_back(chosen_candidate->request->pickup);
+          r.path.push_back(chosen_candidate->request->delivery);
+          r.path.push_back(instance.get_depot());
+          r.evaluate();
+          solution.add_route(r);
+          modified.insert(v);
+        }
+
+        std::swap(*chosen_candidate, candidates.back());
+        candidates.pop_back();
+
+        // Update candidates against the modified routes only
+        #pragma omp parallel for schedule(dynamic) if(parallel && candidates.size() >= min_parallel_candidates)
+        for (int i = 0; i < (int) candidates.size(); i++) {
+          for (Vehicle *v : modified)
+            candidates[i].insertions[v] = get_cheapest_insertion(candidates[i].request, solution.routes.at(v));
+
+          candidates[i].update_route(solution, regret_k);
+        }
+      }
+
+      return true;
+    }
+
+    Route get_cheapest_insertion(Request *req, Solution s)
+    {
+      Route best;
+      double delta = best.cost = FLT_MAX;
+
+      for (std::pair<Vehicle*, Route> pair : s.routes) {
+	      Route r = pair.second;
+        Route curr = get_cheapest_insertion(req, r);
+
+        if (curr.feasible() && curr.cost - r.cost < delta) {
+          delta = curr.cost - r.cost;
+          best = curr;
+        }
+      }
+
+      return best;
+    }
+
+    Route get_cheapest_insertion(Request *req, Route r)
+    {
+      Instance &instance = *r.instance;
+
+      Route best;
+      best.cost = FLT_MAX;
+
+      int n = r.path.size();
+
+      /* Earliest service times and loads at every position of the route, before and after inserting the pickup,
+       * so that feasibility checks don't need to recompute the whole prefix of the route.
+       */
+      std::vector<double> earliest(n), pickup_earliest(n + 1);
+      std::vector<int> load(n), pickup_load(n + 1);
+
+      earliest[0] = r.path[0]->arrival_time;
+      load[0] = 0;
+
+      for (int i = 1; i < n; i++) {
+        earliest[i] = std::max(
+          r.path[i]->arrival_time, earliest[i - 1] + r.path[i - 1]->service_time + instance.get_travel_time(r.path[i - 1], r.path[i])
+        );
+
+        load[i] = load[i - 1] + r.path[i]->load;
+      }
+
+      for (int p = 1; p < n; p++) {
+        bool discard = false;
+        r.insert_node(req->pickup, p);
+
+        for (int i = p; i <= n; i++) {
+          double previous_earliest = i == p ? earliest[p - 1] : pickup_earliest[i - 1];
+          int previous_load = i == p ? load[p - 1] : pickup_load[i - 1];
+
+          pickup_earliest[i] = std::max(
+            r.path[i]->arrival_time, previous_earliest + r.path[i - 1]->service_time + instance.get_travel_time(r.path[i - 1], r.path[i])
+          );
+
+          pickup_load[i] = previous_load + r.path[i]->load;
+        }
+
+        // Nodes between pickup and delivery are checked at once by the first of them violating a constraint
+        int first_violation = n + 1;
+
+        for (int i = p + 1; i <= n && first_violation > n; i++)
+          if ((pickup_earliest[i] > r.path[i]->departure_time) || (pickup_load[i - 1] + r.path[i]->load > r.vehicle->capacity))
+            first_violation = i;
+
+        if ((pickup_earliest[p] <= r.path[p]->departure_time) && (load[p - 1] + r.path[p]->load <= r.vehicle->capacity)) {
+          for (int d = p + 1; d < r.path.size(); d++) {
+            r.insert_node(req->delivery, d);
+
+            if (r.cost < best.cost) {
+              double delivery_earliest = std::max(
+                r.path[d]->arrival_time,
+                pickup_earliest[d - 1] + r.path[d - 1]->service_time + instance.get_travel_time(r.path[d - 1], r.path[d])
+              );
+
+              if (first_violation < d || (delivery_earliest > r.path[d]->departure_time) ||
+                  (pickup_load[d - 1] + r.path[d]->load > r.vehicle->capacity)) {
+                discard = true;
+                goto ERASE_DELIVERY;
+              }
+
+              double time_gap_between_pickup_delivery = delivery_earliest - r.path[p]->departure_time - r.path[p]->service_time;
+
+              if (time_gap_between_pickup_delivery > r.path[p]->max_ride_time) {
+                discard = true;
+                goto ERASE_DELIVERY;
+              }
+              else if (r.evaluate()) {
+                best = r;
+              }
+            }
+
+            ERASE_DELIVERY:
+            r.erase_node(d);
+
+            if (discard)
+              goto ERASE_PICKUP;
+          }
+        }
+
+        ERASE_PICKUP:
+        r.erase_node(p);
+      }
+
+      return best;
+    }
+
+    /*
+     * Restrict the candidate moves of an operator according to the acceptance strategy. Sampling keeps
+     * `sample_size` candidates chosen at random.
+     */
+    template <typename Candidate>
+    void sample_candidates(std::vector<Candidate> &candidates, Strategy strategy)
+    {
+      if (strategy.type == Strategy::Type::SAMPLED && strategy.sample_size < (int) candidates.size()) {
+        // Partial Fisher-Yates shuffle, only the first `sample_size` positions are needed
+        for (int i = 0; i < strategy.sample_size; i++)
+          std::swap(candidates[i], candidates[Random::get(i, (int) candidates.size() - 1)]);
+
+        candidates.resize(strategy.sample_size);
+      }
+    }
+
+    /*
+     * Lower bound on the travel cost increase of inserting `req` in route `r`, ignoring every constraint. The pickup
+     * goes after position i and the delivery after position j >= i, so suffix minima over j make it linear-time.
+     */
+    double get_insertion_lower_bound(Request *req, const Route &r)
+    {
+      Instance &instance = *r.instance;
+
+      int n = r.path.size();
+      std::vector<double> delivery_suffix(n, FLT_MAX);
+
+      for (int j = n - 2; j >= 0; j--)
+        delivery_suffix[j] = std::min(
+          j + 1 < n - 1 ? delivery_suffix[j + 1] : FLT_MAX,
+          instance.get_travel_time(r.path[j], req->delivery) + instance.get_travel_time(req->delivery, r.path[j + 1]) -
+          instance.get_travel_time(r.path[j], r.path[j + 1])
+        );
+
+      double bound = FLT_MAX;
+
+      for (int i = 0; i < n - 1; i++) {
+        double pickup = instance.get_travel_time(r.path[i], req->pickup) + instance.get_travel_time(req->pickup, r.path[i + 1]) -
+                        instance.get_travel_time(r.path[i], r.path[i + 1]);
+
+        // Both nodes between the same pair of nodes
+        bound = std::min(bound, instance.get_travel_time(r.path[i], req->pickup) + instance.get_travel_time(req->pickup, req->delivery) +
+                                instance.get_travel_time(req->delivery, r.path[i + 1]) - instance.get_travel_time(r.path[i], r.path[i + 1]));
+
+        if (i + 1 < n - 1)
+          bound = std::min(bound, pickup + delivery_suffix[i + 1]);
+      }
+
+      return bound;
+    }
+
+    /*
+     * States of an ejection chain: the request to insert and the paths of the routes changed along the chain, which
+     * are all that tells the state apart from the solution the chain started from.
+     */
+    typedef std::pair<Request*, std::map<Vehicle*, std::vector<Node*>>> ChainState;
+
+    /*
+     * Insert `req` in `s`, ejecting at most `depth` requests in a chain. Requests already in the chain are never
+     * ejected again, and states which failed before with at least as much depth left are not explored again.
+     * `changed` holds the vehicles whose routes were changed along the chain.
+     */
+    bool extend_ejection_chain(Solution &s, Request *req, int depth, int breadth, std::vector<Request*> &chain,
+                               std::vector<Vehicle*> &changed, std::map<ChainState, int> &failed, RouteSet *modified)
+    {
+      Instance &instance = *s.instance;
+
+      Route best = get_cheapest_insertion(req, s);
+
+      if (best.feasible()) {
+        s.add_route(best);
+
+        if (modified)
+          modified->insert(best.vehicle);
+
+        return true;
+      }
+
+      if (depth == 0)
+        return false;
+
+      ChainState key;
+      key.first = req;
+
+      for (Vehicle *v : changed)
+        key.second[v] = s.routes[v].path;
+
+      auto failed_it = failed.find(key);
+
+      if (failed_it != failed.end() && failed_it->second >= depth)
+        return false;
+
+      struct Ejection {
+        Vehicle *v;
+        Request *ejected;
+        double bound;
+      };
+
+      std::vector<Ejection> ejections;
+
+      for (auto &pair : s.routes) {
+        for (Node *node : pair.second.path) {
+          if (!node->is_pickup())
+            continue;
+
+          Request *ejected = instance.get_request(node);
+
+          // Only requests competing for the same time are worth ejecting
+          if (!instance.compatible(req, ejected) || std::find(chain.begin(), chain.end(), ejected) != chain.end())
+            continue;
+
+          Route removal = pair.second;
+          removal.erase_request(ejected);
+          ejections.push_back({pair.first, ejected, removal.cost - pair.second.cost + get_insertion_lower_bound(req, removal)});
+        }
+      }
+
+      // Cheapest ejections according to the insertion lower bound are tried first
+      std::sort(ejections.begin(), ejections.end(), [] (const Ejection &e1, const Ejection &e2) {
+        return e1.bound < e2.bound;
+      });
+
+      int attempts = 0;
+
+      for (Ejection &e : ejections) {
+        if (attempts == breadth)
+          break;
+
+        Route removal = s.routes[e.v];
+        removal.erase_request(e.ejected);
+
+        Route inserted = get_cheapest_insertion(req, removal);
+
+        if (!inserted.feasible())
+          continue;
+
+        attempts++;
+
+        Solution next = s;
+        next.add_route(inserted);
+        chain.push_back(e.ejected);
+        changed.push_back(e.v);
+
+        RouteSet next_modified;
+
+        if (extend_ejection_chain(next, e.ejected, depth - 1, breadth, chain, changed, failed, &next_modified)) {
+          s = next;
+
+          if (modified) {
+            modified->insert(e.v);
+            modified->insert(next_modified.begin(), next_modified.end());
+          }
+
+          return true;
+        }
+
+        chain.pop_back();
+        changed.pop_back();
+      }
+
+      failed[key] = depth;
+
+      return false;
+    }
+
+    bool insert_with_ejections(Solution &s, Request *req, RouteSet *modified, int depth, int breadth)
+    {
+      std::vector<Request*> chain = {req};
+      std::vector<Vehicle*> changed;
+      std::map<ChainState, int> failed;
+
+      return extend_ejection_chain(s, req, depth, breadth, chain, changed, failed, modified);
+    }
+
+    Solution vnd(Solution s, bool use_randomness, Strategy strategy, double deadline)
+    {
+      // Only feasible solutions are allowed
+      if (!s.feasible())
+        return s;
+
+      std::vector<Move> moves = {two_opt_star, or_opt, reinsert, shift_1_0, swap_1_1};
+
+      /* Routes modified since each neighborhood was last explored without improvement. Moves only depend
+       * on the routes they involve, so moves between unmodified routes are known to be non-improving.
+       */
+      std::vector<RouteSet> modified(moves.size());
+
+      for (RouteSet &routes : modified)
+        for (auto &pair : s.routes)
+          routes.insert(pair.first);
+
+      for (int k = 0; k < (int) moves.size() && omp_get_wtime() < deadline; /* conditional update */) {
+        auto move = use_randomness ? Random::get(moves.begin() + k, moves.end()) : moves.begin() + k;
+        RouteSet &move_modified = modified[move - moves.begin()];
+
+        if (move_modified.empty()) {
+          k++;
+          continue;
+        }
+
+        Solution neighbor = (*move)(s, &move_modified, strategy);
+
+        if (neighbor.cost < s.cost) {
+          for (auto &pair : neighbor.routes)
+            if (pair.second.path != s.routes[pair.first].path)
+              for (RouteSet &routes : modified)
+                routes.insert(pair.first);
+
+          s = neighbor;
+          k = 0;
+        }
+        else {
+          // A sample without improving moves says nothing about the moves left out of it
+          if (strategy.type != Strategy::Type::SAMPLED)
+            move_modified.clear();
+
+          k++;
+        }
+      }
+
+      return s;
+    }
+
+    Solution reinsert(Solution s, const RouteSet *modified, Strategy strategy)
+    {
+      Instance &instance = *s.instance;
+
+      #ifdef DEBUG
+        printf("\n\033[1m\033[33m-> Entering reinsert operator...\033[0m\n");
+      #endif
+
+      // Candidate moves are pairs (route, request), a null request stands for resequencing the whole route
+      std::vector<std::pair<Vehicle*, Request*>> candidates;
+
+      for (auto &pair : s.routes) {
+        if (modified && !modified->count(pair.first))
+          continue;
+
+        // Perform reinsert only in routes with more than one request accommodated
+        if (pair.second.path.size() <= 4)
+          continue;
+
+        if (((int) pair.second.path.size() - 2)/2 <= strategy.resequencing_size)
+          candidates.push_back({pair.first, nullptr});
+        else
+          for (Node *node : pair.second.path)
+            if (node->is_pickup())
+              candidates.push_back({pair.first, instance.get_request(node)});
+      }
+
+      sample_candidates(candidates, strategy);
+
+      // Reinsertions in different routes are independent, so the best one of every route is applied
+      std::unordered_map<Vehicle*, Route, VehicleHash> best_reinsertions;
+
+      for (auto candidate : candidates) {
+        const Route &r = s.routes[candidate.first];
+        Request *req = candidate.second;
+
+        if (!best_reinsertions.count(candidate.first))
+          best_reinsertions[candidate.first] = r;
+
+        Route &best_reinsertion = best_reinsertions[candidate.first];
+        Route curr;
+
+        if (req) {
+          curr = r;
+          curr.erase_request(req);
+          curr = get_cheapest_insertion(req, curr);
+        }
+        else {
+          curr = resequence(r);
+        }
+
+        if (curr.cost < best_reinsertion.cost)
+          best_reinsertion = curr;
+
+        #ifdef DEBUG
+          if (req)
+            printf("\nReinserting request (%d, %d) in route %d\n", req->pickup->id, req->delivery->id, r.vehicle->id);
+          else
+            printf("\nResequencing route %d\n", r.vehicle->id);
+
+          printf("\t-> ");
+
+          for (Node *n : r.path)
+            if (req && (n == req->pickup || n == req->delivery))
+              printf("\033[1m\033[31m%d\033[0m ", n->id);
+            else
+              printf("%d ", n->id);
+
+          printf("(c = %.2lf)\n", r.cost);
+          printf("\t-> ");
+
+          for (Node *n : curr.path)
+            if (req && (n == req->pickup || n == req->delivery))
+              printf("\033[1m\033[32m%d\033[0m ", n->id);
+            else
+              printf("%d ", n->id);
+
+          if (curr.cost < r.cost)
+            printf("(c = \033[1m\033[32m%.2lf\033[0m)\n", curr.cost);
+          else
+            printf("(c = %.2lf)\n", curr.cost);
+        #endif
+
+        if (strategy.type == Strategy::Type::FIRST_IMPROVEMENT && curr.cost < r.cost)
+          break;
+      }
+
+      for (auto &pair : best_reinsertions) {
+        #ifdef DEBUG
+          printf("\n<<<<<< Updated cost of route %d = %.2f >>>>>>\n", pair.first->id, pair.second.cost);
+        #endif
+
+        s.add_route(pair.second);
+      }
+
+      return s;
+    }
+
+    Route resequence(const Route &r)
+    {
+      Instance &instance = *r.instance;
+
+      std::vector<Node*> nodes;
+
+      // Pickups take local indices 0..n-1 and their deliveries n..2n-1
+      for (Node *node : r.path)
+        if (node->is_pickup())
+          nodes.push_back(node);
+
+      int n = nodes.size(), m = 2 * n;
+
+      for (int i = 0; i < n; i++)
+        nodes.push_back(instance.get_request(nodes[i])->delivery);
+
+      Node *depot = r.path.front();
+
+      // Labels form a tree through their parents, so sequences are only built for the labels worth checking
+      struct Label
+      {
+        double cost;
+        double time;
+        int parent;
+        int node;
+      };
+
+      std::vector<Label> labels = {{0.0, depot->arrival_time + depot->service_time, -1, -1}};
+
+      // States of the current layer (all with the same number of visited nodes), keyed by mask * m + last node
+      std::unordered_map<long long, std::vector<int>> layer = {{-1, {0}}};
+
+      for (int visited = 0; visited < m; visited++) {
+        std::unordered_map<long long, std::vector<int>> next;
+
+        for (auto &state : layer) {
+          long long mask = state.first < 0 ? 0 : state.first/m;
+          int load = 0;
+
+          for (int i = 0; i < n; i++)
+            if ((mask >> i & 1) && !(mask >> (n + i) & 1))
+              load += nodes[i]->load;
+
+          for (int j = 0; j < m; j++) {
+            // Nodes are visited once, deliveries after their pickups and within the vehicle's capacity
+            if ((mask >> j & 1) || (j >= n && !(mask >> (j - n) & 1)))
+              continue;
+
+            if (j < n && load + nodes[j]->load > r.vehicle->capacity)
+              continue;
 
-    return run;
-  }
+            std::vector<int> &labels_j = next[(mask | 1LL << j) * m + j];
 
-  namespace details
-  {
-    Solution construct_greedy_randomized_solution(double random_param)
-    {
-      Solution solution;
+            for (int l : state.second) {
+              Node *last = labels[l].node < 0 ? depot : nodes[labels[l].node];
+              double start = std::max(labels[l].time + instance.get_travel_time(last, nodes[j]), nodes[j]->arrival_time);
 
-      for (Vehicle *v : inst.vehicles) {
-        Route r = Route(v);
-        r.path.push_back(inst.get_depot());
-        r.path.push_back(inst.get_depot());
-        solution.add_route(r);
-      }
+              if (start > nodes[j]->departure_time)
+                continue;
 
-      struct Candidate {
-        Route route;
-        Request *request;
-      };
+              Label label = {labels[l].cost + instance.get_travel_time(last, nodes[j]), start + nodes[j]->service_time, l, j};
+              bool dominated = false;
 
-      std::vector<Candidate> candidates;
+              for (int k : labels_j)
+                if (labels[k].cost <= label.cost && labels[k].time <= label.time)
+                  dominated = true;
 
-      // Init candidates
-      for (Request *req : inst.requests)
-        candidates.push_back({get_cheapest_insertion(req, solution), req});
+              if (dominated)
+                continue;
 
-      while (!candidates.empty()) {
-        std::sort(candidates.begin(), candidates.end(), [] (const Candidate &c1, const Candidate &c2) {
-          return c1.route.cost < c2.route.cost;
-        });
+              labels_j.erase(std::remove_if(labels_j.begin(), labels_j.end(), [&] (int k) {
+                return label.cost <= labels[k].cost && label.time <= labels[k].time;
+              }), labels_j.end());
 
-        auto chosen_candidate = Random::get(candidates.begin(), candidates.begin() + (int) (random_param * candidates.size()));
+              labels_j.push_back(labels.size());
+              labels.push_back(label);
+            }
 
-        if (chosen_candidate->route.feasible()) {
-          solution.add_route(chosen_candidate->route);
+            if (labels_j.empty())
+              next.erase((mask | 1LL << j) * m + j);
+          }
         }
-        else {
-          // Activate new vehicle to accomodate the request (thus solution will be infeasible)
-          Vehicle *v = new Vehicle(solution.routes.size() + 1, inst.vehicles[0]->capacity, inst.vehicles[0]->max_route_duration);
-          Route r(v);
 
-          r.path.push_back(inst.get_depot());
-          r.path.push_back(chosen_candidate->request->pickup);
-          r.path.push_back(chosen_candidate->request->delivery);
-          r.path.push_back(inst.get_depot());
-          r.evaluate();
-          solution.add_route(r);
-        }
+        layer.swap(next);
+      }
 
-        candidates.erase(chosen_candidate);
+      // Complete sequences cheaper than the current one, closed at the depot
+      std::vector<std::pair<double, int>> sequences;
 
-        // Update candidates
-        for (Candidate &c : candidates)
-          c.route = get_cheapest_insertion(c.request, solution);
-      }
+      for (auto &state : layer)
+        for (int l : state.second) {
+          double cost = labels[l].cost + instance.get_travel_time(nodes[labels[l].node], depot);
+          double arrival = labels[l].time + instance.get_travel_time(nodes[labels[l].node], depot);
 
-      return solution;
-    }
+          if (cost < r.cost - 1e-6 && arrival <= depot->departure_time)
+            sequences.push_back({cost, l});
+        }
 
-    Route get_cheapest_insertion(Request *req, Solution s)
-    {
-      Route best;
-      double delta = best.cost = FLT_MAX;
+      std::sort(sequences.begin(), sequences.end());
 
-      for (std::pair<Vehicle*, Route> pair : s.routes) {
-	      Route r = pair.second;
-        Route curr = get_cheapest_insertion(req, r);
+      for (auto &sequence : sequences) {
+        Route curr(r.instance, r.vehicle);
+        curr.path.assign(m + 2, depot);
 
-        if (curr.feasible() && curr.cost - r.cost < delta) {
-          delta = curr.cost - r.cost;
-          best = curr;
-        }
+        for (int l = sequence.second, i = m; l > 0; l = labels[l].parent, i--)
+          curr.path[i] = nodes[labels[l].node];
+
+        if (curr.evaluate())
+          return curr;
       }
 
-      return best;
+      return r;
     }
 
-    Route get_cheapest_insertion(Request *req, Route r)
+    /*
+     * Time window data of a sequence of nodes (Vidal et al., 2013): minimum duration, time warp (how late the
+     * sequence must be served), earliest and latest start times and both endpoints.
+     */
+    struct Segment
     {
-      Route best;
-      best.cost = FLT_MAX;
+      double duration;
+      double time_warp;
+      double earliest;
+      double latest;
+      Node *first;
+      Node *last;
+
+      Segment() {};
+
+      Segment(Node *node) : duration(node->service_time), time_warp(0.0), earliest(node->arrival_time),
+                            latest(node->departure_time), first(node), last(node) {};
+    };
+
+    /*
+     * Segment data of the sequence s1 followed by s2, in constant time.
+     */
+    Segment concatenate(Instance &instance, const Segment &s1, const Segment &s2)
+    {
+      Segment s;
+      double delta = s1.duration - s1.time_warp + instance.get_travel_time(s1.last, s2.first);
+      double waiting_time = std::max(s2.earliest - delta - s1.latest, 0.0);
+      double time_warp = std::max(s1.earliest + delta - s2.latest, 0.0);
+
+      s.duration = s1.duration + s2.duration + instance.get_travel_time(s1.last, s2.first) + waiting_time;
+      s.time_warp = s1.time_warp + s2.time_warp + time_warp;
+      s.earliest = std::max(s2.earliest - delta, s1.earliest) - waiting_time;
+      s.latest = std::min(s2.latest - delta, s1.latest) + time_warp;
+      s.first = s1.first;
+      s.last = s2.last;
 
-      for (int p = 1; p < r.path.size(); p++) {
-        bool discard = false;
-        r.insert_node(req->pickup, p);
+      return s;
+    }
 
-        if ((r.get_earliest_time(p) <= r.path[p]->departure_time) && (r.get_load(p - 1) + r.path[p]->load <= r.vehicle->capacity)) {
-          for (int d = p + 1; d < r.path.size(); d++) {
-            r.insert_node(req->delivery, d);
+    Solution or_opt(Solution s, const RouteSet *modified, Strategy strategy)
+    {
+      Instance &instance = *s.instance;
 
-            if (r.cost < best.cost) {
-              for (int i = p + 1; i <= d; i++) {
-                if ((r.get_earliest_time(i) > r.path[i]->departure_time) || (r.get_load(i - 1) + r.path[i]->load > r.vehicle->capacity)) {
-                  discard = true;
-                  goto ERASE_DELIVERY;
-                }
-              }
+      #ifdef DEBUG
+        printf("\n\033[1m\033[33m-> Entering or-opt operator...\033[0m\n");
+      #endif
 
-              double time_gap_between_pickup_delivery = r.get_earliest_time(d) - r.path[p]->departure_time - r.path[p]->service_time;
+      /* Every route is split in units: the starting depot, its zero-load blocks and the ending depot. Candidate
+       * moves are triples (route, block, unit after which the block is moved).
+       */
+      std::unordered_map<Vehicle*, std::vector<std::pair<int, int>>, VehicleHash> units;
+      std::vector<std::tuple<Vehicle*, int, int>> candidates;
 
-              if (time_gap_between_pickup_delivery > r.path[p]->max_ride_time) {
-                discard = true;
-                goto ERASE_DELIVERY;
-              }
-              else if (r.evaluate()) {
-                best = r;
-              }
-            }
+      for (auto &pair : s.routes) {
+        if (modified && !modified->count(pair.first))
+          continue;
 
-            ERASE_DELIVERY:
-            r.erase_node(d);
+        const Route &r = pair.second;
+        std::vector<std::pair<int, int>> &route_units = units[pair.first];
 
-            if (discard)
-              goto ERASE_PICKUP;
+        route_units.push_back({0, 0});
+
+        for (int i = 1, start = 1; i < (int) r.path.size() - 1; i++) {
+          if (r.load[i] == 0) {
+            route_units.push_back({start, i});
+            start = i + 1;
           }
         }
 
-        ERASE_PICKUP:
-        r.erase_node(p);
+        route_units.push_back({(int) r.path.size() - 1, (int) r.path.size() - 1});
+
+        int blocks = route_units.size() - 2;
+
+        for (int m = 1; m <= blocks; m++)
+          for (int x = 0; x <= blocks; x++)
+            if (x != m - 1 && x != m)
+              candidates.push_back(std::make_tuple(pair.first, m, x));
       }
 
-      return best;
-    }
+      sample_candidates(candidates, strategy);
 
-    Solution vnd(Solution s, bool use_randomness)
-    {
-      // Only feasible solutions are allowed
-      if (!s.feasible())
-        return s;
+      // Segment data of every sequence of consecutive units, built once per route
+      std::unordered_map<Vehicle*, std::vector<std::vector<Segment>>, VehicleHash> segments;
 
-      std::vector<Move> moves = {two_opt_star, reinsert, shift_1_0};
+      for (auto &pair : units) {
+        const Route &r = s.routes[pair.first];
+        std::vector<std::pair<int, int>> &route_units = pair.second;
+        std::vector<std::vector<Segment>> &table = segments[pair.first];
 
-      for (int k = 0; k < moves.size(); /* conditional update */) {
-        auto move = use_randomness ? Random::get(moves.begin() + k, moves.end()) : moves.begin() + k;
-        Solution neighbor = (*move)(s);
+        table.resize(route_units.size(), std::vector<Segment>(route_units.size()));
 
-        if (neighbor.cost < s.cost) {
-          s = neighbor;
-          k = 0;
-        }
-        else {
-          k++;
+        for (int i = 0; i < (int) route_units.size(); i++) {
+          Segment unit(r.path[route_units[i].first]);
+
+          for (int k = route_units[i].first + 1; k <= route_units[i].second; k++)
+            unit = concatenate(instance, unit, Segment(r.path[k]));
+
+          table[i][i] = unit;
         }
+
+        for (int i = 0; i < (int) route_units.size(); i++)
+          for (int j = i + 1; j < (int) route_units.size(); j++)
+            table[i][j] = concatenate(instance, table[i][j - 1], table[j][j]);
       }
 
-      return s;
-    }
+      // Relocations in different routes are independent, so the best one of every route is applied
+      std::unordered_map<Vehicle*, Route, VehicleHash> best_relocations;
 
-    Solution reinsert(Solution s)
-    {
-      #ifdef DEBUG
-        printf("\n\033[1m\033[33m-> Entering reinsert operator...\033[0m\n");
-      #endif
+      for (auto candidate : candidates) {
+        Vehicle *v = std::get<0>(candidate);
+        int m = std::get<1>(candidate), x = std::get<2>(candidate);
 
-      for (std::pair<Vehicle*, Route> pair : s.routes) {
-	      Route r = pair.second;
-        Route best_reinsertion = r;
+        const Route &r = s.routes[v];
+        const std::vector<std::pair<int, int>> &route_units = units[v];
+        const std::vector<std::vector<Segment>> &table = segments[v];
+        int last = route_units.size() - 1;
 
-        #ifdef DEBUG
-          printf("\n<<<<<< Initial cost of route %d = %.2f >>>>>>\n", best_reinsertion.vehicle->id, best_reinsertion.cost);
-        #endif
+        if (!best_relocations.count(v))
+          best_relocations[v] = r;
 
-        // Perform reinsert only in routes with more than one request accommodated
-        if (r.path.size() > 4) {
-          for (int i = 0; i < r.path.size(); i++) {
-            Node *node = r.path[i];
-
-            if (node->is_pickup()) {
-              Request *req = inst.get_request(node);
-              Route curr = r;
-
-              curr.erase_request(req);
-              curr = get_cheapest_insertion(req, curr);
-
-              if (curr.cost < best_reinsertion.cost)
-                best_reinsertion = curr;
-
-              #ifdef DEBUG
-                printf("\nReinserting request (%d, %d) in route %d\n", req->pickup->id, req->delivery->id, r.vehicle->id);
-                printf("\t-> ");
-
-                for (Node *n : r.path)
-                  if (n == req->pickup || n == req->delivery)
-                    printf("\033[1m\033[31m%d\033[0m ", n->id);
-                  else
-                    printf("%d ", n->id);
-
-                printf("(c = %.2lf)\n", r.cost);
-                printf("\t-> ");
-
-                for (Node *n : curr.path)
-                  if (n == req->pickup || n == req->delivery)
-                    printf("\033[1m\033[32m%d\033[0m ", n->id);
-                  else
-                    printf("%d ", n->id);
-
-                if (curr.cost < r.cost)
-                  printf("(c = \033[1m\033[32m%.2lf\033[0m)\n", curr.cost);
-                else
-                  printf("(c = %.2lf)\n", curr.cost);
-              #endif
-            }
-          }
+        Route &best_relocation = best_relocations[v];
+
+        const Segment &block = table[m][m];
+
+        // Travel cost delta from the endpoints of the block and of its old and new neighbors
+        double delta = instance.get_travel_time(table[m - 1][m - 1].last, table[m + 1][m + 1].first) -
+                       instance.get_travel_time(table[m - 1][m - 1].last, block.first) -
+                       instance.get_travel_time(block.last, table[m + 1][m + 1].first) +
+                       instance.get_travel_time(table[x][x].last, block.first) +
+                       instance.get_travel_time(block.last, table[x + 1][x + 1].first) -
+                       instance.get_travel_time(table[x][x].last, table[x + 1][x + 1].first);
+
+        if (r.cost + delta >= best_relocation.cost)
+          continue;
+
+        auto join = [&] (const Segment &s1, const Segment &s2) {
+          return concatenate(instance, s1, s2);
+        };
+
+        Segment route_segment = x < m ?
+          join(join(join(table[0][x], block), table[x + 1][m - 1]), table[m + 1][last]) :
+          join(join(join(table[0][m - 1], table[m + 1][x]), block), table[x + 1][last]);
+
+        if (route_segment.time_warp > 0.0 || route_segment.duration > v->max_route_duration)
+          continue;
+
+        Route curr(&instance, v);
+        int block_start = route_units[m].first, block_end = route_units[m].second;
+
+        for (int u = 0; u <= last; u++) {
+          if (u == m)
+            continue;
+
+          curr.path.insert(curr.path.end(), r.path.begin() + route_units[u].first, r.path.begin() + route_units[u].second + 1);
+
+          if (u == x)
+            curr.path.insert(curr.path.end(), r.path.begin() + block_start, r.path.begin() + block_end + 1);
         }
 
-        #ifdef DEBUG
-          printf("\n<<<<<< Updated cost of route %d = %.2f >>>>>>\n", best_reinsertion.vehicle->id, best_reinsertion.cost);
-        #endif
+        if (curr.evaluate() && curr.cost < best_relocation.cost) {
+          #ifdef DEBUG
+            printf("\nMoving block %d of R%d after unit %d (c = %.2lf -> %.2lf)\n", m, v->id, x, r.cost, curr.cost);
+          #endif
 
-        s.add_route(best_reinsertion);
+          best_relocation = curr;
+
+          if (strategy.type == Strategy::Type::FIRST_IMPROVEMENT)
+            break;
+        }
       }
 
+      for (auto &pair : best_relocations)
+        s.add_route(pair.second);
+
       return s;
     }
 
     Solution repair(Solution s)
     {
-      int extra_vehicles = s.routes.size() - inst.vehicles.size();
+      Instance &instance = *s.instance;
+
+      int extra_vehicles = s.routes.size() - instance.vehicles.size();
 
       #ifdef DEBUG
         printf("\n\033[1m\033[33m-> Repairing infeasible solution with %d extra vehicle(s)...\033[0m\n", extra_vehicles);
@@ -353,8 +1346,9 @@ namespace algorithms
       for (int i = 0; i < extra_vehicles; i++) {
         for (Node *node : routes[i].second.path)
           if (node->is_pickup())
-            unplanned.push_back(inst.get_request(node));
+            unplanned.push_back(instance.get_request(node));
 
+        s.cost -= routes[i].second.cost;
         s.routes.erase(routes[i].first);
       }
 
@@ -362,13 +1356,18 @@ namespace algorithms
         auto request = Random::get(unplanned);
         Route best = get_cheapest_insertion(*request, s);
 
+        if (!best.feasible() && insert_with_ejections(s, *request)) {
+          unplanned.erase(request);
+          continue;
+        }
+
         if (!best.feasible()) {
           #ifdef DEBUG
             printf("\n\t-> No feasible insertion found! Solution will remain infeasible.\n");
           #endif
 
           // Add a null vehicle to make solution infeasible again
-          s.add_route(Route(nullptr));
+          s.add_route(Route(&instance, nullptr));
           return s;
         }
 
@@ -397,6 +1396,8 @@ namespace algorithms
 
     Solution perturb(Solution s)
     {
+      Instance &instance = *s.instance;
+
       #ifdef DEBUG
         printf("\n\033[1m\033[33m-> Perturbing solution...\033[0m\n\n");
 
@@ -413,48 +1414,45 @@ namespace algorithms
         }
       #endif
 
-      int non_empty_routes = 0;
+      // Vehicles are picked by id rather than by the order of the routes
+      std::vector<Vehicle*> vehicles;
 
-      for (auto pair : s.routes)
+      for (auto &pair : s.routes)
         if (!pair.second.empty())
-          non_empty_routes++;
+          vehicles.push_back(pair.first);
 
-      if (non_empty_routes < 3)
+      if (vehicles.size() < 3)
         return s;
 
+      std::sort(vehicles.begin(), vehicles.end(), [] (Vehicle *v1, Vehicle *v2) {
+        return v1->id < v2->id;
+      });
+
       Vehicle *v1, *v2, *v3;
 
-      do {
-        v1 = Random::get(s.routes)->first;
-      }
-      while (s.routes[v1].empty());
+      v1 = *Random::get(vehicles);
 
       do {
-        v2 = Random::get(s.routes)->first;
+        v2 = *Random::get(vehicles);
       }
-      while (s.routes[v2].empty() || v2 == v1);
+      while (v2 == v1);
 
       do {
-        v3 = Random::get(s.routes)->first;
+        v3 = *Random::get(vehicles);
       }
-      while (s.routes[v3].empty() || v3 == v1 || v3 == v2);
-
-      Request *req1 = inst.get_request(s.routes[v1].path[Random::get(1, (int) s.routes[v1].path.size() - 2)]);
-      Request *req2 = inst.get_request(s.routes[v2].path[Random::get(1, (int) s.routes[v2].path.size() - 2)]);
-      Request *req3 = inst.get_request(s.routes[v3].path[Random::get(1, (int) s.routes[v3].path.size() - 2)]);
-
-      // s.routes[v1].erase_request(req1);
-      // s.routes[v2].erase_request(req2);
-      // s.routes[v3].erase_request(req3);
-
-      s.routes[v1].path.erase(std::remove(s.routes[v1].path.begin(), s.routes[v1].path.end(), req1->pickup), s.routes[v1].path.end());
-      s.routes[v1].path.erase(std::remove(s.routes[v1].path.begin(), s.routes[v1].path.end(), req1->delivery), s.routes[v1].path.end());
+      while (v3 == v1 || v3 == v2);
 
-      s.routes[v2].path.erase(std::remove(s.routes[v2].path.begin(), s.routes[v2].path.end(), req2->pickup), s.routes[v2].path.end());
-      s.routes[v2].path.erase(std::remove(s.routes[v2].path.begin(), s.routes[v2].path.end(), req2->delivery), s.routes[v2].path.end());
+      Request *req1 = instance.get_request(s.routes[v1].path[Random::get(1, (int) s.routes[v1].path.size() - 2)]);
+      Request *req2 = instance.get_request(s.routes[v2].path[Random::get(1, (int) s.routes[v2].path.size() - 2)]);
+      Request *req3 = instance.get_request(s.routes[v3].path[Random::get(1, (int) s.routes[v3].path.size() - 2)]);
 
-      s.routes[v3].path.erase(std::remove(s.routes[v3].path.begin(), s.routes[v3].path.end(), req3->pickup), s.routes[v3].path.end());
-      s.routes[v3].path.erase(std::remove(s.routes[v3].path.begin(), s.routes[v3].path.end(), req3->delivery), s.routes[v3].path.end());
+      // Routes are evaluated right away, as insertions and ejection chains rely on their costs and schedules
+      for (auto pair : {std::make_pair(v1, req1), std::make_pair(v2, req2), std::make_pair(v3, req3)}) {
+        Route r = s.routes[pair.first];
+        r.erase_request(pair.second);
+        r.evaluate();
+        s.add_route(r);
+      }
 
       #ifdef DEBUG
         printf("\n\033[1m\033[32mRemoved request (%d, %d) from R%d:\033[0m\n", req1->pickup->id, req1->delivery->id, v1->id);
@@ -474,19 +1472,21 @@ namespace algorithms
         printf("(c = %.2f)\n", s.routes[v2].cost);
       #endif
 
+      // Insertions are computed one at a time, since an ejection chain may modify any route
       Route best1 = get_cheapest_insertion(req1, s.routes[v2]);
-      Route best2 = get_cheapest_insertion(req2, s.routes[v3]);
-      Route best3 = get_cheapest_insertion(req3, s.routes[v1]);
 
-      if (!best1.feasible()) {
+      if (!best1.feasible() && insert_with_ejections(s, req1)) {
+        // Request inserted by ejecting others
+      }
+      else if (!best1.feasible()) {
         // Activate new vehicle to accomodate the request
-        Vehicle *v = new Vehicle(s.routes.size() + 1, inst.vehicles[0]->capacity, inst.vehicles[0]->max_route_duration);
-        Route r(v);
+        Vehicle *v = new Vehicle(s.routes.size() + 1, instance.vehicles[0]->capacity, instance.vehicles[0]->max_route_duration);
+        Route r(&instance, v);
 
-        r.path.push_back(inst.get_depot());
+        r.path.push_back(instance.get_depot());
         r.path.push_back(req1->pickup);
         r.path.push_back(req1->delivery);
-        r.path.push_back(inst.get_depot());
+        r.path.push_back(instance.get_depot());
         r.evaluate();
         s.add_route(r);
       }
@@ -494,15 +1494,20 @@ namespace algorithms
         s.add_route(best1);
       }
 
-      if (!best2.feasible()) {
+      Route best2 = get_cheapest_insertion(req2, s.routes[v3]);
+
+      if (!best2.feasible() && insert_with_ejections(s, req2)) {
+        // Request inserted by ejecting others
+      }
+      else if (!best2.feasible()) {
         // Activate new vehicle to accomodate the request
-        Vehicle *v = new Vehicle(s.routes.size() + 1, inst.vehicles[0]->capacity, inst.vehicles[0]->max_route_duration);
-        Route r(v);
+        Vehicle *v = new Vehicle(s.routes.size() + 1, instance.vehicles[0]->capacity, instance.vehicles[0]->max_route_duration);
+        Route r(&instance, v);
 
-        r.path.push_back(inst.get_depot());
+        r.path.push_back(instance.get_depot());
         r.path.push_back(req2->pickup);
         r.path.push_back(req2->delivery);
-        r.path.push_back(inst.get_depot());
+        r.path.push_back(instance.get_depot());
         r.evaluate();
         s.add_route(r);
       }
@@ -510,15 +1515,20 @@ namespace algorithms
         s.add_route(best2);
       }
 
-      if (!best3.feasible()) {
+      Route best3 = get_cheapest_insertion(req3, s.routes[v1]);
+
+      if (!best3.feasible() && insert_with_ejections(s, req3)) {
+        // Request inserted by ejecting others
+      }
+      else if (!best3.feasible()) {
         // Activate new vehicle to accomodate the request
-        Vehicle *v = new Vehicle(s.routes.size() + 1, inst.vehicles[0]->capacity, inst.vehicles[0]->max_route_duration);
-        Route r(v);
+        Vehicle *v = new Vehicle(s.routes.size() + 1, instance.vehicles[0]->capacity, instance.vehicles[0]->max_route_duration);
+        Route r(&instance, v);
 
-        r.path.push_back(inst.get_depot());
+        r.path.push_back(instance.get_depot());
         r.path.push_back(req3->pickup);
         r.path.push_back(req3->delivery);
-        r.path.push_back(inst.get_depot());
+        r.path.push_back(instance.get_depot());
         r.evaluate();
         s.add_route(r);
       }
@@ -551,23 +1561,30 @@ namespace algorithms
       return s;
     }
 
-    Solution two_opt_star(Solution s)
+    Solution two_opt_star(Solution s, const RouteSet *modified, Strategy strategy)
     {
       #ifdef DEBUG
         printf("\n\033[1m\033[33m-> Entering 2-opt* operator...\033[0m\n");
       #endif
 
-      Solution best = s;
+      struct Candidate {
+        Vehicle *v1;
+        int i;
+        Vehicle *v2;
+        int j;
+      };
+
+      std::vector<Candidate> candidates;
 
-      for (std::pair<Vehicle*, Route> p1 : s.routes) {
+      for (auto &p1 : s.routes) {
 	      Vehicle *v1 = p1.first;
-	      Route r1 = p1.second;
+	      const Route &r1 = p1.second;
 
-        for (std::pair<Vehicle*, Route> p2 : s.routes) {
+        for (auto &p2 : s.routes) {
 	        Vehicle *v2 = p2.first;
-	        Route r2 = p2.second;
+	        const Route &r2 = p2.second;
 
-          if (v1 != v2) {
+          if (v1 != v2 && (!modified || modified->count(v1) || modified->count(v2))) {
             int r1_load = 0;
 
             for (int i = 0; i < r1.path.size() - 1; i++) {
@@ -579,68 +1596,11 @@ namespace algorithms
                 for (int j = 0; j < r2.path.size() - 1; j++) {
                   r2_load += r2.path[j]->load;
 
-                  if (r2_load == 0) {
-                    /* There is no point in exchanging segments when they're both immediately after depot
-                     * or immediately before depot, since this operation will yield the original routes.
-                     */
-                    if (!(i == 0 && j == 0) && !(i == r1.path.size() - 2 && j == r2.path.size() - 2)) {
-                      Route new_r1(r1.vehicle);
-                      Route new_r2(r2.vehicle);
-
-                      new_r1.path.insert(new_r1.path.end(), r1.path.begin(), r1.path.begin() + i + 1);
-                      new_r1.path.insert(new_r1.path.end(), r2.path.begin() + j + 1, r2.path.end());
-
-                      new_r2.path.insert(new_r2.path.end(), r2.path.begin(), r2.path.begin() + j + 1);
-                      new_r2.path.insert(new_r2.path.end(), r1.path.begin() + i + 1, r1.path.end());
-
-                      // Neighbor solution will be feasible if and only if both routes can be evaluated
-                      if (new_r1.evaluate() && new_r2.evaluate()) {
-                        Solution neighbor = s;
-                        neighbor.add_route(new_r1);
-                        neighbor.add_route(new_r2);
-
-                        if (neighbor.cost < best.cost)
-                          best = neighbor;
-                      }
-
-                      #ifdef DEBUG
-                        printf("\nApplying 2-opt* to routes:");
-                        printf("\n\tR%d: ", r1.vehicle->id);
-                        for (int k = 0; k < r1.path.size(); k++) {
-                          printf("%d ", r1.path[k]->id);
-
-                          if (k == i)
-                            printf("\033[1m\033[31m|\033[0m ");
-                        }
-
-                        printf("\n\tR%d: ", r2.vehicle->id);
-                        for (int k = 0; k < r2.path.size(); k++) {
-                          printf("%d ", r2.path[k]->id);
-
-                          if (k == j)
-                            printf("\033[1m\033[31m|\033[0m ");
-                        }
-
-                        printf("\n\n\tR%d': ", new_r1.vehicle->id);
-                        for (int k = 0; k < new_r1.path.size(); k++) {
-                          printf("%d ", new_r1.path[k]->id);
-
-                          if (k == i)
-                            printf("\033[1m\033[34m|\033[0m ");
-                        }
-
-                        printf("\n\tR%d': ", new_r2.vehicle->id);
-                        for (int k = 0; k < new_r2.path.size(); k++) {
-                          printf("%d ", new_r2.path[k]->id);
-
-                          if (k == j)
-                            printf("\033[1m\033[34m|\033[0m ");
-                        }
-
-                        printf("\n");
-                      #endif
-                    }
-                  }
+                  /* There is no point in exchanging segments when they're both immediately after depot
+                   * or immediately before depot, since this operation will yield the original routes.
+                   */
+                  if (r2_load == 0 && !(i == 0 && j == 0) && !(i == (int) r1.path.size() - 2 && j == (int) r2.path.size() - 2))
+                    candidates.push_back({v1, i, v2, j});
                 }
               }
             }
@@ -648,15 +1608,109 @@ namespace algorithms
         }
       }
 
+      sample_candidates(candidates, strategy);
+
+      Solution best = s;
+
+      for (Candidate c : candidates) {
+        const Route &r1 = s.routes[c.v1];
+        const Route &r2 = s.routes[c.v2];
+        int i = c.i, j = c.j;
+
+        Route new_r1(r1.instance, r1.vehicle);
+        Route new_r2(r2.instance, r2.vehicle);
+
+        new_r1.path.insert(new_r1.path.end(), r1.path.begin(), r1.path.begin() + i + 1);
+        new_r1.path.insert(new_r1.path.end(), r2.path.begin() + j + 1, r2.path.end());
+
+        new_r2.path.insert(new_r2.path.end(), r2.path.begin(), r2.path.begin() + j + 1);
+        new_r2.path.insert(new_r2.path.end(), r1.path.begin() + i + 1, r1.path.end());
+
+        // Neighbor solution will be feasible if and only if both routes can be evaluated
+        if (new_r1.evaluate() && new_r2.evaluate()) {
+          Solution neighbor = s;
+          neighbor.add_route(new_r1);
+          neighbor.add_route(new_r2);
+
+          if (neighbor.cost < best.cost)
+            best = neighbor;
+        }
+
+        #ifdef DEBUG
+          printf("\nApplying 2-opt* to routes:");
+          printf("\n\tR%d: ", r1.vehicle->id);
+          for (int k = 0; k < r1.path.size(); k++) {
+            printf("%d ", r1.path[k]->id);
+
+            if (k == i)
+              printf("\033[1m\033[31m|\033[0m ");
+          }
+
+          printf("\n\tR%d: ", r2.vehicle->id);
+          for (int k = 0; k < r2.path.size(); k++) {
+            printf("%d ", r2.path[k]->id);
+
+            if (k == j)
+              printf("\033[1m\033[31m|\033[0m ");
+          }
+
+          printf("\n\n\tR%d': ", new_r1.vehicle->id);
+          for (int k = 0; k < new_r1.path.size(); k++) {
+            printf("%d ", new_r1.path[k]->id);
+
+            if (k == i)
+              printf("\033[1m\033[34m|\033[0m ");
+          }
+
+          printf("\n\tR%d': ", new_r2.vehicle->id);
+          for (int k = 0; k < new_r2.path.size(); k++) {
+            printf("%d ", new_r2.path[k]->id);
+
+            if (k == j)
+              printf("\033[1m\033[34m|\033[0m ");
+          }
+
+          printf("\n");
+        #endif
+
+        if (strategy.type == Strategy::Type::FIRST_IMPROVEMENT && best.cost < s.cost)
+          break;
+      }
+
       return best;
     }
 
-    Solution shift_1_0(Solution s)
+    Solution shift_1_0(Solution s, const RouteSet *modified, Strategy strategy)
     {
+      Instance &instance = *s.instance;
+
       #ifdef DEBUG
         printf("\n\033[1m\033[33m-> Entering shift-1-0 operator...\033[0m\n");
       #endif
 
+      struct Candidate {
+        Vehicle *v1;
+        Request *req;
+        Vehicle *v2;
+      };
+
+      std::vector<Candidate> candidates;
+
+      for (auto &pair1 : s.routes) {
+	      Vehicle *v1 = pair1.first;
+
+        for (auto &pair2 : s.routes) {
+	        Vehicle *v2 = pair2.first;
+
+          if (v1 != v2 && (!modified || modified->count(v1) || modified->count(v2)))
+            for (Node *node : pair1.second.path)
+              if (node->is_pickup())
+                candidates.push_back({v1, instance.get_request(node), v2});
+        }
+      }
+
+      sample_candidates(candidates, strategy);
+
       std::pair<Route, Route> best_shift;
 
       /* Let delta be the gain of shifting a given request from one route to another.
@@ -664,71 +1718,61 @@ namespace algorithms
        */
       double delta = 0;
 
-      for (std::pair<Vehicle*, Route> pair1 : s.routes) {
-	      Vehicle *v1 = pair1.first;
-        Route r1 = pair1.second;
+      for (Candidate c : candidates) {
+        Vehicle *v1 = c.v1, *v2 = c.v2;
+        Request *req = c.req;
+        const Route &r1 = s.routes[v1];
+        const Route &r2 = s.routes[v2];
+        Route new_r2 = get_cheapest_insertion(req, r2);
 
-        for (std::pair<Vehicle*, Route> pair2 : s.routes) {
-	        Vehicle *v2 = pair2.first;
-	        Route r2 = pair2.second;
-
-          if (v1 != v2) {
-            for (int i = 0; i < r1.path.size(); i++) {
-              Node *node = r1.path[i];
-
-              if (node->is_pickup()) {
-                Request *req = inst.get_request(node);
-                Route new_r2 = get_cheapest_insertion(req, r2);
-
-                if (new_r2.feasible()) {
-                  Route new_r1 = r1;
-                  new_r1.erase_request(req);
-
-                  double gain = (new_r1.cost + new_r2.cost) - (r1.cost + r2.cost);
-
-                  #ifdef DEBUG
-                    printf("\nShifting request (%d, %d) from R%d to R%d\n", req->pickup->id, req->delivery->id, v1->id, v2->id);
-
-                    printf("\tR%d: ", v1->id);
-                    for (Node *n : r1.path)
-                      if (n == req->pickup || n == req->delivery)
-                        printf("\033[1m\033[31m%d\033[0m ", n->id);
-                      else
-                        printf("%d ", n->id);
-                    printf("(c = %.2lf)\n", r1.cost);
-
-                    printf("\tR%d: ", v2->id);
-                    for (Node *n : r2.path)
-                      printf("%d ", n->id);
-                    printf("(c = %.2lf)\n", r2.cost);
-
-                    printf("\n\tR%d': ", v1->id);
-                    for (Node *n : new_r1.path)
-                        printf("%d ", n->id);
-                    printf("(c = %.2lf)\n", new_r1.cost);
-
-                    printf("\tR%d': ", v2->id);
-                    for (Node *n : new_r2.path)
-                      if (n == req->pickup || n == req->delivery)
-                        printf("\033[1m\033[32m%d\033[0m ", n->id);
-                      else
-                        printf("%d ", n->id);
-                    printf("(c = %.2lf)\n", new_r2.cost);
-
-                    if (gain < delta)
-                      printf("\n\t\033[1m\033[34mΔf = %.2f\033[0m\n", gain);
-                    else
-                      printf("\n\tΔf = %.2f\n", gain);
-                  #endif
-
-                  if (gain < delta) {
-                    new_r1.evaluate(); // Update decision variables
-                    best_shift = std::make_pair(new_r1, new_r2);
-                    delta = gain;
-                  }
-                }
-              }
-            }
+        if (new_r2.feasible()) {
+          Route new_r1 = r1;
+          new_r1.erase_request(req);
+
+          double gain = (new_r1.cost + new_r2.cost) - (r1.cost + r2.cost);
+
+          #ifdef DEBUG
+            printf("\nShifting request (%d, %d) from R%d to R%d\n", req->pickup->id, req->delivery->id, v1->id, v2->id);
+
+            printf("\tR%d: ", v1->id);
+            for (Node *n : r1.path)
+              if (n == req->pickup || n == req->delivery)
+                printf("\033[1m\033[31m%d\033[0m ", n->id);
+              else
+                printf("%d ", n->id);
+            printf("(c = %.2lf)\n", r1.cost);
+
+            printf("\tR%d: ", v2->id);
+            for (Node *n : r2.path)
+              printf("%d ", n->id);
+            printf("(c = %.2lf)\n", r2.cost);
+
+            printf("\n\tR%d': ", v1->id);
+            for (Node *n : new_r1.path)
+                printf("%d ", n->id);
+            printf("(c = %.2lf)\n", new_r1.cost);
+
+            printf("\tR%d': ", v2->id);
+            for (Node *n : new_r2.path)
+              if (n == req->pickup || n == req->delivery)
+                printf("\033[1m\033[32m%d\033[0m ", n->id);
+              else
+                printf("%d ", n->id);
+            printf("(c = %.2lf)\n", new_r2.cost);
+
+            if (gain < delta)
+              printf("\n\t\033[1m\033[34mΔf = %.2f\033[0m\n", gain);
+            else
+              printf("\n\tΔf = %.2f\n", gain);
+          #endif
+
+          if (gain < delta) {
+            new_r1.evaluate(); // Update decision variables
+            best_shift = std::make_pair(new_r1, new_r2);
+            delta = gain;
+
+            if (strategy.type == Strategy::Type::FIRST_IMPROVEMENT)
+              break;
           }
         }
       }
@@ -741,5 +1785,122 @@ namespace algorithms
 
       return s;
     }
+
+    Solution swap_1_1(Solution s, const RouteSet *modified, Strategy strategy)
+    {
+      Instance &instance = *s.instance;
+
+      #ifdef DEBUG
+        printf("\n\033[1m\033[33m-> Entering swap-1-1 operator...\033[0m\n");
+      #endif
+
+      struct Candidate {
+        Vehicle *v1;
+        Request *req1;
+        Vehicle *v2;
+        Request *req2;
+      };
+
+      std::vector<Candidate> candidates;
+
+      for (auto &pair1 : s.routes) {
+        Vehicle *v1 = pair1.first;
+
+        for (auto &pair2 : s.routes) {
+          Vehicle *v2 = pair2.first;
+
+          // Swaps are symmetric, so every pair of routes is explored only once
+          if (v1->id < v2->id && (!modified || modified->count(v1) || modified->count(v2)))
+            for (Node *n1 : pair1.second.path)
+              if (n1->is_pickup())
+                for (Node *n2 : pair2.second.path)
+                  if (n2->is_pickup() && instance.compatible(instance.get_request(n1), instance.get_request(n2)))
+                    candidates.push_back({v1, instance.get_request(n1), v2, instance.get_request(n2)});
+        }
+      }
+
+      sample_candidates(candidates, strategy);
+
+      // Route without each request, shared by all the swaps involving that request
+      std::unordered_map<Request*, Route, RequestHash> removals;
+
+      for (Candidate c : candidates) {
+        if (!removals.count(c.req1)) {
+          removals[c.req1] = s.routes[c.v1];
+          removals[c.req1].erase_request(c.req1);
+        }
+
+        if (!removals.count(c.req2)) {
+          removals[c.req2] = s.routes[c.v2];
+          removals[c.req2].erase_request(c.req2);
+        }
+      }
+
+      auto removal_gain = [&] (const Candidate &c) {
+        return (removals[c.req1].cost - s.routes[c.v1].cost) + (removals[c.req2].cost - s.routes[c.v2].cost);
+      };
+
+      // Swaps with the largest removal gains first, so that a good swap is found early and prunes the others
+      std::sort(candidates.begin(), candidates.end(), [&] (const Candidate &c1, const Candidate &c2) {
+        return removal_gain(c1) < removal_gain(c2);
+      });
+
+      std::pair<Route, Route> best_swap;
+      double delta = 0;
+
+      // Travel times of a file, e.g. asymmetric or with default times, may violate the triangle inequality
+      bool euclidean = instance.travel_times.is_euclidean();
+
+      for (Candidate c : candidates) {
+        const Route &r1 = s.routes[c.v1];
+        const Route &r2 = s.routes[c.v2];
+        const Route &removal1 = removals[c.req1];
+        const Route &removal2 = removals[c.req2];
+
+        // Insertions then never decrease the travel cost, so removal gains bound the gain of the swap
+        if (euclidean && removal_gain(c) >= delta)
+          continue;
+
+        // Tighter bound from travel costs alone, before paying for any route evaluation
+        double lower_bound1 = get_insertion_lower_bound(c.req2, removal1);
+        double lower_bound2 = get_insertion_lower_bound(c.req1, removal2);
+
+        if (removal_gain(c) + lower_bound1 + lower_bound2 >= delta)
+          continue;
+
+        Route new_r1 = get_cheapest_insertion(c.req2, removal1);
+
+        if (!new_r1.feasible() || (new_r1.cost - r1.cost) + (removal2.cost - r2.cost) + lower_bound2 >= delta)
+          continue;
+
+        Route new_r2 = get_cheapest_insertion(c.req1, removal2);
+
+        if (!new_r2.feasible())
+          continue;
+
+        double gain = (new_r1.cost + new_r2.cost) - (r1.cost + r2.cost);
+
+        #ifdef DEBUG
+          printf("\nSwapping request (%d, %d) of R%d with request (%d, %d) of R%d (\u0394f = %.2f)\n",
+                 c.req1->pickup->id, c.req1->delivery->id, c.v1->id, c.req2->pickup->id, c.req2->delivery->id,
+                 c.v2->id, gain);
+        #endif
+
+        if (gain < delta) {
+          best_swap = std::make_pair(new_r1, new_r2);
+          delta = gain;
+
+          if (strategy.type == Strategy::Type::FIRST_IMPROVEMENT)
+            break;
+        }
+      }
+
+      if (delta < 0) {
+        s.add_route(best_swap.first);
+        s.add_route(best_swap.second);
+      }
+
+      return s;
+    }
   } // namespace reactive_grasp_impl
 } // namespace algorithms
@@ -0,0 +1,300 @@
+/**
+ * @file   alns.cpp
+ * @author Diego Paiva
+ * @date   18/10/2026
+ */
+
+#include "algorithms.hpp"
+#include "instance.hpp"
+
+#include <cfloat>    // FLT_MAX
+#include <cmath>     // exp, log, pow
+#include <algorithm> // std::sort
+#include <omp.h>     // omp_get_wtime
+
+namespace algorithms
+{
+  using namespace details;
+
+  Run alns(Instance &instance, int iterations, int segment_size, double reaction_factor, double cooling_rate,
+           double max_removal, double random_param)
+  {
+    Run run;
+    double start = omp_get_wtime();
+
+    // Seed the Random engine of each thread, from std::random_device unless a seed was set
+    unsigned int seed = get_seed();
+    Random::seed(seed);
+    run.seeds.push_back(seed);
+
+    do {
+      run.init = construct_greedy_randomized_solution(instance, random_param);
+
+      if (!run.init.feasible())
+        run.init = repair(run.init);
+    }
+    while (!run.init.feasible());
+
+    Solution curr = run.best = run.init;
+    run.convergence.push_back({omp_get_wtime() - start, run.best.cost});
+
+    std::vector<Destroy> destroys = {random_removal, worst_removal, shaw_removal, route_removal};
+    std::vector<Repair> repairs = {greedy_insertion, regret_insertion};
+
+    std::vector<double> destroy_weights(destroys.size(), 1.0), destroy_scores(destroys.size(), 0.0);
+    std::vector<double> repair_weights(repairs.size(), 1.0), repair_scores(repairs.size(), 0.0);
+    std::vector<int> destroy_uses(destroys.size(), 0), repair_uses(repairs.size(), 0);
+
+    // Scores of (Ropke and Pisinger, 2006): new best, better than current and accepted worse solutions
+    const double new_best_score = 33, improvement_score = 9, acceptance_score = 13;
+
+    // Start at a temperature in which a solution 5% worse than the initial one is accepted with probability 0.5
+    double temperature = -0.05 * run.init.cost/log(0.5);
+
+    int min_q = 2, max_q = std::max(min_q, (int) (max_removal * instance.requests.size()));
+
+    std::unordered_set<size_t> visited;
+    std::hash<std::string> hash;
+
+    for (int it = 1; it <= iterations && !out_of_time(start); it++) {
+      std::discrete_distribution<int> destroy_distribution(destroy_weights.begin(), destroy_weights.end());
+      std::discrete_distribution<int> repair_distribution(repair_weights.begin(), repair_weights.end());
+
+      int d = Random::get(destroy_distribution);
+      int r = Random::get(repair_distribution);
+
+      Solution s = curr;
+      std::vector<Request*> removed = destroys[d](s, Random::get(min_q, max_q));
+
+      destroy_uses[d]++;
+      repair_uses[r]++;
+
+      if (repairs[r](s, removed)) {
+        double score = 0.0;
+
+        if (s.cost < run.best.cost) {
+          run.best = s;
+          run.convergence.push_back({omp_get_wtime() - start, run.best.cost});
+          score = new_best_score;
+        }
+        else if (s.cost < curr.cost) {
+          score = improvement_score;
+        }
+        else if (Random::get(0.0, 1.0) < exp((curr.cost - s.cost)/temperature)) {
+          score = acceptance_score;
+        }
+
+        if (score > 0.0) {
+          // Operators are only rewarded for solutions not visited before
+          if (!visited.insert(hash(s.to_key())).second)
+            score = 0.0;
+
+          curr = s;
+        }
+
+        destroy_scores[d] += score;
+        repair_scores[r] += score;
+      }
+
+      temperature *= cooling_rate;
+
+      if (it % segment_size == 0) {
+        for (int i = 0; i < (int) destroys.size(); i++) {
+          if (destroy_uses[i] > 0)
+            destroy_weights[i] = destroy_weights[i] * (1 - reaction_factor) + reaction_factor * destroy_scores[i]/destroy_uses[i];
+
+          // Keep every operator selectable
+          destroy_weights[i] = std::max(destroy_weights[i], 0.01);
+          destroy_scores[i] = 0.0;
+          destroy_uses[i] = 0;
+        }
+
+        for (int i = 0; i < (int) repairs.size(); i++) {
+          if (repair_uses[i] > 0)
+            repair_weights[i] = repair_weights[i] * (1 - reaction_factor) + reaction_factor * repair_scores[i]/repair_uses[i];
+
+          repair_weights[i] = std::max(repair_weights[i], 0.01);
+          repair_scores[i] = 0.0;
+          repair_uses[i] = 0;
+        }
+      }
+    }
+
+    // A single local search pass at the end is enough to polish the best solution without hurting throughput
+    run.best = vnd(run.best, false, Strategy(), get_deadline(start));
+    run.convergence.push_back({omp_get_wtime() - start, run.best.cost});
+
+    run.init.delete_empty_routes();
+    run.best.delete_empty_routes();
+
+    double finish = omp_get_wtime();
+    run.elapsed_seconds = finish - start;
+
+    return run;
+  }
+
+  namespace details
+  {
+    void remove_request(Solution &s, Vehicle *v, Request *req)
+    {
+      Route r = s.routes[v];
+      r.erase_request(req);
+      r.evaluate();
+      s.add_route(r);
+    }
+
+    std::unordered_map<Request*, Vehicle*, RequestHash> get_assignments(Solution &s)
+    {
+      std::unordered_map<Request*, Vehicle*, RequestHash> assignments;
+
+      for (auto &pair : s.routes)
+        for (Node *node : pair.second.path)
+          if (node->is_pickup())
+            assignments[s.instance->get_request(node)] = pair.first;
+
+      return assignments;
+    }
+
+    std::vector<Request*> random_removal(Solution &s, int q)
+    {
+      std::unordered_map<Request*, Vehicle*, RequestHash> assignments = get_assignments(s);
+      std::vector<Request*> requests;
+
+      for (auto &pair : assignments)
+        requests.push_back(pair.first);
+
+      Random::shuffle(requests);
+      requests.resize(std::min(q, (int) requests.size()));
+
+      for (Request *req : requests)
+        remove_request(s, assignments[req], req);
+
+      return requests;
+    }
+
+    std::vector<Request*> worst_removal(Solution &s, int q)
+    {
+      std::unordered_map<Request*, Vehicle*, RequestHash> assignments = get_assignments(s);
+      std::vector<std::pair<double, Request*>> gains;
+
+      for (auto &pair : assignments) {
+        Route r = s.routes[pair.second];
+        double cost = r.cost;
+
+        // Cost is updated incrementally as nodes are erased
+        r.erase_request(pair.first);
+        gains.push_back({cost - r.cost, pair.first});
+      }
+
+      std::sort(gains.begin(), gains.end(), [] (const std::pair<double, Request*> &g1, const std::pair<double, Request*> &g2) {
+        return g1.first > g2.first;
+      });
+
+      std::vector<Request*> removed;
+
+      while ((int) removed.size() < q && !gains.empty()) {
+        // Randomization degree of (Ropke and Pisinger, 2006) to avoid removing the very same requests every time
+        int i = (int) (pow(Random::get(0.0, 1.0), 3) * gains.size());
+        Request *req = gains[i].second;
+
+        remove_request(s, assignments[req], req);
+        removed.push_back(req);
+        gains.erase(gains.begin() + i);
+      }
+
+      return removed;
+    }
+
+    std::vector<Request*> shaw_removal(Solution &s, int q)
+    {
+      Instance &instance = *s.instance;
+      std::unordered_map<Request*, Vehicle*, RequestHash> assignments = get_assignments(s);
+      std::vector<Request*> requests;
+
+      for (auto &pair : assignments)
+        requests.push_back(pair.first);
+
+      if (requests.empty())
+        return requests;
+
+      double max_distance = 0.0, horizon = 0.0;
+      const double *depot_row = instance.travel_times.row(instance.get_depot()->index);
+
+      for (Node *node : instance.nodes) {
+        max_distance = std::max(max_distance, depot_row[node->index]);
+        horizon = std::max(horizon, node->departure_time);
+      }
+
+      std::vector<Request*> removed = {*Random::get(requests)};
+      requests.erase(std::find(requests.begin(), requests.end(), removed[0]));
+
+      while ((int) removed.size() < q && !requests.empty()) {
+        Request *seed = *Random::get(removed);
+
+        // Travel times from the seed are read from its rows, computed once per seed in lazy mode
+        const double *pickup_row = instance.travel_times.row(seed->pickup->index);
+        const double *delivery_row = instance.travel_times.row(seed->delivery->index);
+
+        // Relatedness of a request to the seed according to their locations and time windows (lower is more related)
+        auto relatedness = [&] (Request *req) {
+          return (pickup_row[req->pickup->index] + delivery_row[req->delivery->index])/max_distance +
+                 (fabs(seed->pickup->arrival_time - req->pickup->arrival_time) +
+                  fabs(seed->delivery->departure_time - req->delivery->departure_time))/horizon;
+        };
+
+        std::sort(requests.begin(), requests.end(), [&] (Request *r1, Request *r2) {
+          return relatedness(r1) < relatedness(r2);
+        });
+
+        int i = (int) (pow(Random::get(0.0, 1.0), 6) * requests.size());
+        removed.push_back(requests[i]);
+        requests.erase(requests.begin() + i);
+      }
+
+      for (Request *req : removed)
+        remove_request(s, assignments[req], req);
+
+      return removed;
+    }
+
+    std::vector<Request*> route_removal(Solution &s, int q)
+    {
+      Instance &instance = *s.instance;
+      std::vector<Vehicle*> vehicles;
+
+      for (auto &pair : s.routes)
+        if (!pair.second.empty())
+          vehicles.push_back(pair.first);
+
+      std::vector<Request*> removed;
+
+      if (vehicles.empty())
+        return removed;
+
+      Vehicle *v = *Random::get(vehicles);
+
+      for (Node *node : s.routes[v].path)
+        if (node->is_pickup())
+          removed.push_back(instance.get_request(node));
+
+      // Empty routes are evaluated too, so that their schedules match their paths
+      Route r(&instance, v);
+      r.path.push_back(instance.get_depot());
+      r.path.push_back(instance.get_depot());
+      r.evaluate();
+      s.add_route(r);
+
+      return removed;
+    }
+
+    bool greedy_insertion(Solution &s, std::vector<Request*> requests)
+    {
+      return insert_requests(s, requests, 0.0, 1, false);
+    }
+
+    bool regret_insertion(Solution &s, std::vector<Request*> requests)
+    {
+      return insert_requests(s, requests, 0.0, 3, false);
+    }
+  } // namespace details
+} // namespace algorithms
@@ -44,12 +44,13 @@ void gnuplot::details::call_gnuplot(std::vector<std::string> args)
   popen(cmd.c_str(), "w");
 }
 
-void gnuplot::plot_convergence_analysis(std::unordered_map<std::string, std::vector<Run>> runs, std::string output)
+void gnuplot::plot_convergence_analysis(const Instance &instance, std::unordered_map<std::string, std::vector<Run>> runs,
+                                        std::string output)
 {
   const std::string script = "../extras/scripts/gnuplot/convergence_analysis.gp";
 
   // Data to be used in the plot
-  std::string data_file = "conv-" + inst.name + ".dat";
+  std::string data_file = "conv-" + instance.name + ".dat";
   std::ofstream data_stream(data_file, std::ofstream::out | std::ofstream::trunc);
 
   for (Run run : runs["grasp"]) {
@@ -69,12 +70,13 @@ void gnuplot::plot_convergence_analysis(std::unordered_map<std::string, std::vec
   details::call_gnuplot({script, data_file, output});
 }
 
-void gnuplot::tttplot(std::unordered_map<std::string, std::vector<Run>> runs, double target, std::string output)
+void gnuplot::tttplot(const Instance &instance, std::unordered_map<std::string, std::vector<Run>> runs, double target,
+                      std::string output)
 {
   const std::string script = "../extras/scripts/gnuplot/tttplot.gp";
 
   // Data to be used in the plot
-  std::string data_file = "tttplot-" + inst.name + ".dat";
+  std::string data_file = "tttplot-" + instance.name + ".dat";
   std::ofstream data_stream(data_file, std::ofstream::out | std::ofstream::trunc);
   std::vector<double> grasp_times_to_target;
   std::vector<double> ils_times_to_target;
@@ -112,13 +114,13 @@ void gnuplot::details::plot_solution_graph(Solution s, std::string output)
 
   // Header metadata
   data_stream << "# Instance name, Solution cost, Number of routes, Number of requests" << "\n"
-              << inst.name << ' ' << s.cost << ' ' << s.routes.size() << ' ' <<  inst.requests.size() << "\n";
+              << s.instance->name << ' ' << s.cost << ' ' << s.routes.size() << ' ' <<  s.instance->requests.size() << "\n";
 
   // Each datablock must be separated by two line breaks
   data_stream << "\n\n";
 
   data_stream << "# Id, Latitude, Longitude" << "\n";
-  for (Node *node : inst.nodes)
+  for (Node *node : s.instance->nodes)
     data_stream << node->id << " " << node->latitude << " " << node->longitude << '\n';
 
   data_stream << "\n\n";
@@ -160,7 +162,7 @@ void gnuplot::details::plot_schedule(Route r, std::string output)
       color++;
     }
     else if (r.path[i]->is_delivery()) {
-      colors[r.path[i]->id] = colors[r.path[i]->id - inst.requests.size()];
+      colors[r.path[i]->id] = colors[r.path[i]->id - r.instance->requests.size()];
     }
     else {
       colors[r.path[i]->id] = 0;
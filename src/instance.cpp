@@ -6,10 +6,336 @@
 
 #include "instance.hpp"
 
-#include <iostream> // std::cerr
-#include <fstream>  // std::ifstream
-#include <cmath>    // sqrt, pow
-#include <regex>
+#include <stdexcept> // std::runtime_error
+#include <cstdlib>   // strtod
+#include <cstdint>   // uint32_t, int64_t
+#include <cstring>   // std::memcmp, std::memcpy, std::memset
+#include <cstdio>    // rename, remove
+#include <memory>    // std::unique_ptr
+#include <fstream>   // std::ofstream
+#include <climits>   // LLONG_MAX
+#include <algorithm> // std::min
+#include <fcntl.h>   // open
+#include <unistd.h>  // close, access, getpid
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace
+{
+  /*
+   * Read-only memory mapping of a whole file, unmapped when it goes out of scope.
+   */
+  class MappedFile
+  {
+  public:
+    const char *begin = nullptr;
+    const char *end = nullptr;
+
+    MappedFile(const std::string &file_name)
+    {
+      int fd = open(file_name.c_str(), O_RDONLY);
+      struct stat st;
+
+      if (fd < 0 || fstat(fd, &st) < 0) {
+        if (fd >= 0)
+          close(fd);
+
+        throw std::runtime_error("Failed to read file '" + file_name + "'");
+      }
+
+      // Empty files can't be mapped, they're reported as missing a header by the parser
+      if (st.st_size > 0) {
+        void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (data == MAP_FAILED) {
+          close(fd);
+          throw std::runtime_error("Failed to map file '" + file_name + "'");
+        }
+
+        madvise(data, st.st_size, MADV_SEQUENTIAL);
+        begin = static_cast<const char*>(data);
+        end = begin + st.st_size;
+      }
+
+      close(fd);
+    }
+
+    ~MappedFile()
+    {
+      if (begin)
+        munmap(const_cast<char*>(begin), end - begin);
+    }
+
+    // Hand the mapping over to the caller, who becomes responsible for unmapping it
+    void release()
+    {
+      begin = end = nullptr;
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    void operator=(const MappedFile&) = delete;
+  };
+
+  /*
+   * Cursor over the whitespace-separated fields of a text file, which keeps track of the current line.
+   */
+  class Parser
+  {
+  private:
+    const char *p;
+    const char *end;
+    std::string file_name;
+
+    bool is_blank(char c)
+    {
+      return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+    }
+
+    bool is_digit(char c)
+    {
+      return c >= '0' && c <= '9';
+    }
+
+    double finish(const char *first, bool negative, unsigned long long mantissa, int digits, int exponent)
+    {
+      static const double powers[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+      };
+
+      // Mantissa and power of ten are exact doubles, so a single operation rounds correctly (Clinger, 1990)
+      if (digits <= 19 && mantissa < (1ULL << 53) && exponent >= -22 && exponent <= 22) {
+        double value = exponent < 0 ? mantissa/powers[-exponent] : mantissa * powers[exponent];
+        return negative ? -value : value;
+      }
+
+      // Rare slow path, the mapped file isn't null-terminated so the field is copied
+      return strtod(std::string(first, p).c_str(), nullptr);
+    }
+
+    // Check that a number isn't glued to other characters, as in "12ab"
+    void end_field(const char *what)
+    {
+      if (p < end && !is_blank(*p) && *p != '\n')
+        fail(std::string("invalid ") + what);
+    }
+
+  public:
+    int line = 1;
+
+    Parser(const char *begin, const char *end, const std::string &file_name) : p(begin), end(end),
+                                                                              file_name(file_name) {};
+
+    void fail(const std::string &message)
+    {
+      throw std::runtime_error(file_name + ":" + std::to_string(line) + ": " + message);
+    }
+
+    // Skip blank lines, returns `false` at the end of the file
+    bool next_line()
+    {
+      for (; p < end && (is_blank(*p) || *p == '\n'); p++)
+        if (*p == '\n')
+          line++;
+
+      return p < end;
+    }
+
+    // Fields of a record must all be in the same line
+    void skip_blanks(const char *what)
+    {
+      while (p < end && is_blank(*p))
+        p++;
+
+      if (p == end || *p == '\n')
+        fail(std::string("missing ") + what);
+    }
+
+    // Nothing but blanks may follow the last field of a record
+    void end_line()
+    {
+      while (p < end && is_blank(*p))
+        p++;
+
+      if (p < end && *p != '\n')
+        fail("unexpected trailing data");
+    }
+
+    long long parse_int(const char *what)
+    {
+      skip_blanks(what);
+
+      bool negative = *p == '-';
+
+      if (*p == '-' || *p == '+')
+        p++;
+
+      if (p == end || !is_digit(*p))
+        fail(std::string("invalid ") + what);
+
+      long long value = 0;
+
+      for (; p < end && is_digit(*p); p++) {
+        if (value > (LLONG_MAX - 9)/10)
+          fail(std::string("out of range ") + what);
+
+        value = 10 * value + (*p - '0');
+      }
+
+      end_field(what);
+
+      return negative ? -value : value;
+    }
+
+    double parse_double(const char *what)
+    {
+      skip_blanks(what);
+
+      const char *first = p;
+      bool negative = *p == '-';
+
+      if (*p == '-' || *p == '+')
+        p++;
+
+      // Decimal digits are accumulated as an integer mantissa and a power of ten
+      unsigned long long mantissa = 0;
+      int digits = 0, exponent = 0;
+
+      for (; p < end && is_digit(*p); p++, digits++)
+        if (digits < 19)
+          mantissa = 10 * mantissa + (*p - '0');
+        else
+          exponent++;
+
+      if (p < end && *p == '.')
+        for (p++; p < end && is_digit(*p); p++, digits++)
+          if (digits < 19) {
+            mantissa = 10 * mantissa + (*p - '0');
+            exponent--;
+          }
+
+      if (digits == 0)
+        fail(std::string("invalid ") + what);
+
+      if (p < end && (*p == 'e' || *p == 'E')) {
+        bool negative_exponent = ++p < end && *p == '-';
+
+        if (p < end && (*p == '-' || *p == '+'))
+          p++;
+
+        if (p == end || !is_digit(*p))
+          fail(std::string("invalid ") + what);
+
+        int e = 0;
+
+        for (; p < end && is_digit(*p); p++)
+          e = std::min(10 * e + (*p - '0'), 100000);
+
+        exponent += negative_exponent ? -e : e;
+      }
+
+      end_field(what);
+
+      return finish(first, negative, mantissa, digits, exponent);
+    }
+  };
+
+  /*
+   * Cache files start with this header, followed by the nodes and, in dense mode, the distance matrix and the
+   * compatibility matrix.
+   * Every section has a size multiple of 8 bytes (but the last one), so that the matrices are properly aligned.
+   */
+  struct CacheHeader
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t source_size;
+    int64_t source_mtime;
+    int32_t vehicles;
+    int32_t nodes;
+    int32_t requests;
+    int32_t capacity;
+    int32_t dense;
+    int32_t ordering;
+    int32_t rounded;
+    double max_route_duration;
+    double max_ride_time;
+  };
+
+  struct CachedNode
+  {
+    double latitude;
+    double longitude;
+    double service_time;
+    double arrival_time;
+    double departure_time;
+    double max_ride_time;
+    int32_t id;
+    int32_t load;
+    int32_t type;
+    int32_t index;
+  };
+
+  const char CACHE_MAGIC[8] = "DARPBIN";
+
+  // Bump whenever the layout of the cache or the preprocessing changes
+  const uint32_t CACHE_VERSION = 4;
+
+  // Caches written on machines of different endianness are rejected
+  const uint32_t CACHE_BYTE_ORDER = 0x01020304;
+
+  /*
+   * Whether the pickups of two requests may be served within one maximum ride time of each other.
+   */
+  bool get_compatibility(Node *p1, Node *p2)
+  {
+    // Pickup time windows overlap once widened by the maximum ride time
+    return p1->arrival_time - p1->max_ride_time <= p2->departure_time &&
+           p2->arrival_time - p2->max_ride_time <= p1->departure_time;
+  }
+
+  /*
+   * Position of a point along a Hilbert curve over a 2^16 x 2^16 grid.
+   */
+  uint64_t get_hilbert_position(uint32_t x, uint32_t y)
+  {
+    uint64_t position = 0;
+
+    for (uint32_t s = 1 << 15; s > 0; s >>= 1) {
+      uint32_t rx = (x & s) > 0, ry = (y & s) > 0;
+      position += (uint64_t) s * s * ((3 * rx) ^ ry);
+
+      // Rotate the quadrant, so that the curve is continuous
+      if (ry == 0) {
+        if (rx == 1) {
+          x = s - 1 - x;
+          y = s - 1 - y;
+        }
+
+        std::swap(x, y);
+      }
+    }
+
+    return position;
+  }
+
+  /*
+   * Size and modification time (in nanoseconds) identifying the contents of a file, or `false` if it's missing.
+   */
+  bool get_file_stamp(const std::string &file_name, uint64_t &size, int64_t &mtime)
+  {
+    struct stat st;
+
+    if (stat(file_name.c_str(), &st) < 0)
+      return false;
+
+    size = st.st_size;
+    mtime = (int64_t) st.st_mtim.tv_sec * 1000000000 + st.st_mtim.tv_nsec;
+
+    return true;
+  }
+} // namespace
 
 Instance::~Instance()
 {
@@ -21,48 +347,104 @@ Instance::~Instance()
 
   for (Request *req : requests)
     delete req;
+
+  if (cache)
+    munmap(const_cast<char*>(cache), cache_size);
 }
 
-void Instance::init(const std::string instance_file_name)
+void Instance::init(const std::string instance_file_name, bool use_cache, TravelTimes::Mode mode,
+                    const std::string travel_times_file_name, Ordering ordering)
 {
-  std::ifstream file(instance_file_name);
+  // Instance is named after the file stem
+  size_t slash = instance_file_name.find_last_of('/');
+  name = instance_file_name.substr(slash == std::string::npos ? 0 : slash + 1);
+  name = name.substr(0, name.find_last_of('.'));
+
+  std::string cache_file_name = instance_file_name + ".cache";
+
+  // Caches only hold Euclidean travel times
+  use_cache = use_cache && travel_times_file_name.empty();
 
-  if (!file.is_open()) {
-    std::cerr << "Failed to read file '" << instance_file_name << '\'' << std::endl;
-    exit(1);
+  if (use_cache && load_cache(instance_file_name, cache_file_name, mode, ordering))
+    return;
+
+  parse(instance_file_name);
+
+  if (travel_times_file_name.empty()) {
+    renumber(ordering);
+    travel_times.init(nodes, mode);
+  }
+  else {
+    travel_times.load(nodes, travel_times_file_name);
   }
 
-  std::regex rgx("R(\\d+)(a|b)");
-  std::smatch match;
+  // Add all requests
+  for (int i = 1, requests_num = nodes.size()/2; i <= requests_num; i++)
+    // Request is a pair (i, n + i)
+    requests.push_back(new Request(this, nodes.at(i), nodes.at(requests_num + i)));
+
+  // The compatibility matrix is quadratic too, so it's only built along with a matrix of travel times
+  if (travel_times.is_stored())
+    init_compatibility_matrix();
+
+  if (use_cache)
+    save_cache(instance_file_name, cache_file_name, ordering);
+}
+
+void Instance::parse(const std::string &instance_file_name)
+{
+  MappedFile file(instance_file_name);
+  Parser parser(file.begin, file.end, name);
 
-  if (std::regex_search(instance_file_name.begin(), instance_file_name.end(), match, rgx))
-    name = match[0];
+  if (!parser.next_line())
+    parser.fail("missing header");
 
   // Header metadata
-  int vehicles_num, nodes_num, vehicle_capacity;
-  double max_route_duration, max_ride_time;
+  int vehicles_num = parser.parse_int("number of vehicles");
+  int nodes_num = parser.parse_int("number of nodes");
+  double max_route_duration = parser.parse_double("maximum route duration");
+  int vehicle_capacity = parser.parse_int("vehicle capacity");
+  double max_ride_time = parser.parse_double("maximum ride time");
 
-  file >> vehicles_num;
-  file >> nodes_num;
-  file >> max_route_duration;
-  file >> vehicle_capacity;
-  file >> max_ride_time;
+  parser.end_line();
+
+  if (vehicles_num < 1)
+    parser.fail("number of vehicles must be positive");
+
+  if (nodes_num < 2 || nodes_num % 2 != 0)
+    parser.fail("number of nodes must be positive and even");
+
+  if (vehicle_capacity < 1 || max_route_duration < 0.0 || max_ride_time < 0.0)
+    parser.fail("vehicle capacity must be positive and time limits non-negative");
 
   // Add vehicles
   for (int i = 1; i <= vehicles_num; i++)
     vehicles.push_back(new Vehicle(i, vehicle_capacity, max_route_duration));
 
-  // Build all nodes
-  for (int id = 0; file >> id; ) {
+  // Build all nodes: the depot, followed by pickups and then deliveries
+  nodes.reserve(nodes_num + 1);
+
+  while (parser.next_line()) {
+    int id = parser.parse_int("node id");
+
+    if (id != (int) nodes.size())
+      parser.fail("expected node " + std::to_string(nodes.size()) + ", found " + std::to_string(id));
+
+    if (id > nodes_num)
+      parser.fail("more nodes than the " + std::to_string(nodes_num) + " declared in the header");
+
     Node *node = new Node(id);
+    nodes.push_back(node);
+
     node->max_ride_time = max_ride_time;
+    node->latitude = parser.parse_double("latitude");
+    node->longitude = parser.parse_double("longitude");
+    node->service_time = parser.parse_double("service time");
+    node->load = parser.parse_int("load");
+    node->arrival_time = parser.parse_double("time window start");
+    node->departure_time = parser.parse_double("time window end");
 
-    file >> node->latitude;
-    file >> node->longitude;
-    file >> node->service_time;
-    file >> node->load;
-    file >> node->arrival_time;
-    file >> node->departure_time;
+    parser.end_line();
 
     // Add type of node
     if (node->load > 0)
@@ -72,30 +454,217 @@ void Instance::init(const std::string instance_file_name)
     else
       node->type = Node::Type::DEPOT;
 
+    Node::Type expected = id == 0 ? Node::Type::DEPOT : (id <= nodes_num/2 ? Node::Type::PICKUP : Node::Type::DELIVERY);
+
+    if (node->type != expected)
+      parser.fail("load of node " + std::to_string(id) + " doesn't match its position");
+
+    if (node->arrival_time > node->departure_time)
+      parser.fail("time window of node " + std::to_string(id) + " ends before it starts");
+  }
+
+  if ((int) nodes.size() != nodes_num + 1)
+    parser.fail("expected " + std::to_string(nodes_num + 1) + " nodes, found " + std::to_string(nodes.size()));
+}
+
+bool Instance::load_cache(const std::string &instance_file_name, const std::string &cache_file_name,
+                          TravelTimes::Mode mode, Ordering ordering)
+{
+  uint64_t source_size;
+  int64_t source_mtime;
+
+  if (!get_file_stamp(instance_file_name, source_size, source_mtime) || access(cache_file_name.c_str(), R_OK) < 0)
+    return false;
+
+  std::unique_ptr<MappedFile> file;
+
+  try {
+    file.reset(new MappedFile(cache_file_name));
+  }
+  catch (const std::runtime_error&) {
+    return false;
+  }
+
+  size_t size = file->end - file->begin;
+
+  if (size < sizeof(CacheHeader))
+    return false;
+
+  const CacheHeader *header = reinterpret_cast<const CacheHeader*>(file->begin);
+
+  if (std::memcmp(header->magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || header->version != CACHE_VERSION ||
+      header->byte_order != CACHE_BYTE_ORDER || header->source_size != source_size ||
+      header->source_mtime != source_mtime || header->nodes != 2 * header->requests + 1 ||
+      header->ordering != static_cast<int32_t>(ordering))
+    return false;
+
+  size_t n = header->nodes, m = header->requests;
+
+  if (mode == TravelTimes::Mode::AUTO)
+    mode = n <= TravelTimes::max_dense_nodes ? TravelTimes::Mode::DENSE : TravelTimes::Mode::LAZY;
+
+  // Other modes only need the nodes, which are found in every cache, as long as their time windows were tightened
+  // with travel times rounded alike
+  bool dense = mode == TravelTimes::Mode::DENSE;
+  bool rounded = mode == TravelTimes::Mode::FLOAT32 || mode == TravelTimes::Mode::QUANTIZED;
+
+  if ((dense && !header->dense) || header->rounded != rounded ||
+      size != sizeof(CacheHeader) + n * sizeof(CachedNode) + (header->dense ? n * n * sizeof(double) + m * m : 0))
+    return false;
+
+  const CachedNode *cached_nodes = reinterpret_cast<const CachedNode*>(file->begin + sizeof(CacheHeader));
+
+  for (int i = 1; i <= header->vehicles; i++)
+    vehicles.push_back(new Vehicle(i, header->capacity, header->max_route_duration));
+
+  nodes.reserve(n);
+
+  for (size_t i = 0; i < n; i++) {
+    Node *node = new Node(cached_nodes[i].id);
+
+    node->latitude = cached_nodes[i].latitude;
+    node->longitude = cached_nodes[i].longitude;
+    node->service_time = cached_nodes[i].service_time;
+    node->load = cached_nodes[i].load;
+    node->arrival_time = cached_nodes[i].arrival_time;
+    node->departure_time = cached_nodes[i].departure_time;
+    node->type = static_cast<Node::Type>(cached_nodes[i].type);
+    node->max_ride_time = cached_nodes[i].max_ride_time;
+    node->index = cached_nodes[i].index;
+
     nodes.push_back(node);
   }
 
-  init_distance_matrix();
+  // Time windows were tightened before caching
+  for (size_t i = 1; i <= m; i++)
+    requests.push_back(new Request(this, nodes[i], nodes[m + i], false));
 
-  // Add all requests
-  for (int i = 1, requests_num = nodes.size()/2; i <= requests_num; i++)
-    // Request is a pair (i, n + i)
-    requests.push_back(new Request(nodes.at(i), nodes.at(requests_num + i)));
+  if (dense) {
+    travel_times.init(nodes, reinterpret_cast<const double*>(cached_nodes + n));
+    compatibility_matrix = reinterpret_cast<const char*>(travel_times.data() + n * n);
+  }
+  else {
+    travel_times.init(nodes, mode);
+
+    if (travel_times.is_stored())
+      init_compatibility_matrix();
+  }
+
+  cache = file->begin;
+  cache_size = size;
+  file->release();
+
+  return true;
 }
 
-void Instance::init_distance_matrix()
+void Instance::save_cache(const std::string &instance_file_name, const std::string &cache_file_name,
+                          Ordering ordering)
 {
-  distance_matrix.resize(nodes.size());
+  CacheHeader header;
+  std::memset(&header, 0, sizeof(header));
+
+  if (!get_file_stamp(instance_file_name, header.source_size, header.source_mtime))
+    return;
 
-  for (int i = 0; i < distance_matrix.size(); i++) {
-    distance_matrix[i].resize(nodes.size());
+  std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+  header.version = CACHE_VERSION;
+  header.byte_order = CACHE_BYTE_ORDER;
+  header.vehicles = vehicles.size();
+  header.nodes = nodes.size();
+  header.requests = requests.size();
+  header.capacity = vehicles.front()->capacity;
+  header.dense = travel_times.get_mode() == TravelTimes::Mode::DENSE;
+  header.ordering = static_cast<int32_t>(ordering);
+  header.rounded = travel_times.is_rounded();
+  header.max_route_duration = vehicles.front()->max_route_duration;
+  header.max_ride_time = nodes.front()->max_ride_time;
+
+  std::vector<CachedNode> cached_nodes(nodes.size());
+
+  for (int i = 0; i < (int) nodes.size(); i++) {
+    std::memset(&cached_nodes[i], 0, sizeof(CachedNode));
+
+    cached_nodes[i].latitude = nodes[i]->latitude;
+    cached_nodes[i].longitude = nodes[i]->longitude;
+    cached_nodes[i].service_time = nodes[i]->service_time;
+    cached_nodes[i].arrival_time = nodes[i]->arrival_time;
+    cached_nodes[i].departure_time = nodes[i]->departure_time;
+    cached_nodes[i].max_ride_time = nodes[i]->max_ride_time;
+    cached_nodes[i].id = nodes[i]->id;
+    cached_nodes[i].load = nodes[i]->load;
+    cached_nodes[i].type = static_cast<int32_t>(nodes[i]->type);
+    cached_nodes[i].index = nodes[i]->index;
+  }
+
+  // Concurrent runs may write the same cache, so it's written to a temporary file and atomically renamed
+  std::string temp_file_name = cache_file_name + "." + std::to_string(getpid()) + ".tmp";
+  std::ofstream file(temp_file_name, std::ios::binary);
+
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char*>(cached_nodes.data()), cached_nodes.size() * sizeof(CachedNode));
+
+  if (header.dense) {
+    file.write(reinterpret_cast<const char*>(travel_times.data()), nodes.size() * nodes.size() * sizeof(double));
+    file.write(compatibilities.data(), compatibilities.size());
+  }
+
+  file.close();
+
+  if (!file || rename(temp_file_name.c_str(), cache_file_name.c_str()) < 0)
+    remove(temp_file_name.c_str());
+}
 
-    for (int j = 0; j < distance_matrix.size(); j++) {
-      distance_matrix[i][j] = sqrt(
-        pow(nodes[i]->latitude - nodes[j]->latitude, 2) + pow(nodes[i]->longitude - nodes[j]->longitude, 2)
-      );
+void Instance::init_compatibility_matrix()
+{
+  size_t m = requests.size();
+  compatibilities.resize(m * m);
+
+  for (size_t i = 0; i < m; i++) {
+    for (size_t j = 0; j < m; j++) {
+      compatibilities[i * m + j] = get_compatibility(requests[i]->pickup, requests[j]->pickup);
     }
   }
+
+  compatibility_matrix = compatibilities.data();
+}
+
+void Instance::renumber(Ordering ordering)
+{
+  std::vector<std::pair<double, Node*>> keys;
+
+  double min_x = nodes[0]->latitude, max_x = min_x, min_y = nodes[0]->longitude, max_y = min_y;
+
+  for (Node *node : nodes) {
+    min_x = std::min(min_x, node->latitude);
+    max_x = std::max(max_x, node->latitude);
+    min_y = std::min(min_y, node->longitude);
+    max_y = std::max(max_y, node->longitude);
+  }
+
+  for (Node *node : nodes) {
+    double key = node->id;
+
+    if (ordering == Ordering::HILBERT) {
+      // Coordinates are scaled to the grid of the curve
+      uint32_t x = max_x > min_x ? (node->latitude - min_x)/(max_x - min_x) * 65535 : 0;
+      uint32_t y = max_y > min_y ? (node->longitude - min_y)/(max_y - min_y) * 65535 : 0;
+      key = get_hilbert_position(x, y);
+    }
+    else if (ordering == Ordering::TIME_WINDOW) {
+      key = node->arrival_time;
+    }
+
+    keys.push_back({key, node});
+  }
+
+  // Ties keep the order of the file
+  std::stable_sort(keys.begin(), keys.end(), [] (const std::pair<double, Node*> &k1,
+                                                 const std::pair<double, Node*> &k2) {
+    return k1.first < k2.first;
+  });
+
+  for (int i = 0; i < (int) keys.size(); i++)
+    keys[i].second->index = i;
 }
 
 Instance& Instance::get_unique()
@@ -116,5 +685,13 @@ Node* Instance::get_depot()
 
 double Instance::get_travel_time(Node *n1, Node *n2)
 {
-  return distance_matrix[n1->id][n2->id];
+  return travel_times.get(n1->index, n2->index);
+}
+
+bool Instance::compatible(Request *r1, Request *r2)
+{
+  if (!compatibility_matrix)
+    return get_compatibility(r1->pickup, r2->pickup);
+
+  return compatibility_matrix[(r1->pickup->id - 1) * requests.size() + r2->pickup->id - 1];
 }
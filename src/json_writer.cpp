@@ -0,0 +1,185 @@
+/**
+ * @file   json_writer.cpp
+ * @author Diego Paiva
+ * @date   18/10/2026
+ */
+
+#include "json_writer.hpp"
+
+#include <stdexcept> // std::runtime_error
+#include <cmath>     // std::isfinite
+
+JsonWriter::JsonWriter(const std::string &file_name) : after_key(false)
+{
+  file = fopen(file_name.c_str(), "w");
+
+  if (!file)
+    throw std::runtime_error("Failed to open file '" + file_name + "'");
+}
+
+JsonWriter::~JsonWriter()
+{
+  fclose(file);
+}
+
+void JsonWriter::separate()
+{
+  if (after_key) {
+    after_key = false;
+    return;
+  }
+
+  if (empty.empty())
+    return;
+
+  if (!empty.back())
+    fputc(',', file);
+
+  empty.back() = false;
+
+  // Four spaces of indentation per level
+  fprintf(file, "\n%*s", (int) (4 * empty.size()), "");
+}
+
+void JsonWriter::write_string(const std::string &s)
+{
+  fputc('"', file);
+
+  for (char c : s) {
+    switch (c) {
+      case '"':  fputs("\\\"", file); break;
+      case '\\': fputs("\\\\", file); break;
+      case '\n': fputs("\\n", file); break;
+      case '\t': fputs("\\t", file); break;
+      case '\r': fputs("\\r", file); break;
+      default:
+        if ((unsigned char) c < 0x20)
+          fprintf(file, "\\u%04x", (unsigned char) c);
+        else
+          fputc(c, file);
+    }
+  }
+
+  fputc('"', file);
+}
+
+JsonWriter& JsonWriter::begin_object()
+{
+  separate();
+  fputc('{', file);
+  empty.push_back(true);
+
+  return *this;
+}
+
+JsonWriter& JsonWriter::end_object()
+{
+  bool was_empty = empty.back();
+  empty.pop_back();
+
+  if (!was_empty)
+    fprintf(file, "\n%*s", (int) (4 * empty.size()), "");
+
+  fputc('}', file);
+
+  if (empty.empty())
+    fputc('\n', file);
+
+  return *this;
+}
+
+JsonWriter& JsonWriter::begin_array()
+{
+  separate();
+  fputc('[', file);
+  empty.push_back(true);
+
+  return *this;
+}
+
+JsonWriter& JsonWriter::end_array()
+{
+  bool was_empty = empty.back();
+  empty.pop_back();
+
+  if (!was_empty)
+    fprintf(file, "\n%*s", (int) (4 * empty.size()), "");
+
+  fputc(']', file);
+
+  return *this;
+}
+
+JsonWriter& JsonWriter::key(const std::string &k)
+{
+  separate();
+  write_string(k);
+  fputs(": ", file);
+  after_key = true;
+
+  return *this;
+}
+
+JsonWriter& JsonWriter::value(double v, int precision)
+{
+  separate();
+
+  if (std::isfinite(v))
+    fprintf(file, "%.*f", precision, v);
+  else
+    fputs("null", file);
+
+  return *this;
+}
+
+JsonWriter& JsonWriter::value(long long v)
+{
+  separate();
+  fprintf(file, "%lld", v);
+
+  return *this;
+}
+
+JsonWriter& JsonWriter::value(int v)
+{
+  return value((long long) v);
+}
+
+JsonWriter& JsonWriter::value(unsigned int v)
+{
+  return value((long long) v);
+}
+
+JsonWriter& JsonWriter::value(bool v)
+{
+  separate();
+  fputs(v ? "true" : "false", file);
+
+  return *this;
+}
+
+JsonWriter& JsonWriter::value(const std::string &v)
+{
+  separate();
+  write_string(v);
+
+  return *this;
+}
+
+JsonWriter& JsonWriter::value(const char *v)
+{
+  return value(std::string(v));
+}
+
+JsonWriter& JsonWriter::null()
+{
+  separate();
+  fputs("null", file);
+
+  return *this;
+}
+
+void JsonWriter::flush()
+{
+  fflush(file);
+}
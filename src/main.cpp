@@ -7,144 +7,930 @@
 #include "algorithms.hpp"
 #include "gnuplot.hpp"
 #include "instance.hpp"
-#include "json.hpp"
-
-#include <chrono>  // std::chrono
-#include <fstream> // std::ofstream
-#include <iomanip> // std::setprecision, std::setw
-#include <sstream> // std::stringstream
+#include "json_writer.hpp"
+
+#include <chrono>    // std::chrono
+#include <cmath>     // sqrt, log10, round
+#include <cfloat>    // FLT_MAX
+#include <memory>    // std::unique_ptr
+#include <algorithm> // std::sort, std::stable_sort, std::find_if
+#include <stdexcept> // std::invalid_argument
+#include <climits>   // INT_MAX
+#include <cerrno>    // errno
+#include <getopt.h>  // getopt_long
+#include <glob.h>    // glob
+#include <dirent.h>  // opendir, readdir
+#include <sys/stat.h>
+#include <omp.h>     // OpenMP
 
 // Register computation start date
 std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
 
 /*
- * Save execution information and statistics as JSON file.
+ * Running statistics of the runs of an instance, so that finished runs don't have to be kept in memory.
+ */
+struct Statistics
+{
+  int runs = 0;
+  int solved = 0;
+  int best_run = 0;
+  double best_cost = 0.0;
+  double mean_cost = 0.0;
+  double squares = 0.0;
+  double mean_cpu = 0.0;
+
+  void add(const Run &run, int number)
+  {
+    runs++;
+    mean_cpu += (run.elapsed_seconds - mean_cpu)/runs;
+
+    // Runs that found no solution only count in the time statistics
+    if (run.best.cost == FLT_MAX)
+      return;
+
+    solved++;
+
+    if (solved == 1 || run.best.cost < best_cost) {
+      best_run = number;
+      best_cost = run.best.cost;
+    }
+
+    // Welford's update of the mean and of the sum of squared deviations
+    double delta = run.best.cost - mean_cost;
+    mean_cost += delta/solved;
+    squares += delta * (run.best.cost - mean_cost);
+  }
+
+  double standard_deviation() const
+  {
+    return solved > 1 ? sqrt(squares/(solved - 1)) : 0.0;
+  }
+};
+
+/*
+ * Parameters of an execution, as given on the command line and shared by single and batch modes.
+ */
+struct Config
+{
+  std::string engine = "ils";
+  int runs = 1;
+  int threads = 0;
+  int iterations = 0;
+  int no_improvement_iterations = 2500;
+  double time_limit = 0.0;
+  std::vector<double> alphas;
+  bool seeded = false;
+  unsigned int seed = 0;
+  int regret_k = 1;
+  std::string strategy_name = "best";
+  algorithms::Strategy strategy;
+  int pool_capacity = 0;
+  int block_size = 256;
+  int tenure = 0;
+  algorithms::Cooling cooling = algorithms::Cooling::GEOMETRIC;
+  bool use_cache = true;
+  TravelTimes::Mode storage = TravelTimes::Mode::AUTO;
+  Instance::Ordering ordering = Instance::Ordering::FILE;
+  std::string travel_times_file;
+  std::string output = "out.json";
+};
+
+/*
+ * Names of the engines on the command line and as printed along the runs.
+ */
+const std::vector<std::pair<std::string, std::string>> engines = {
+  {"ils", "ILS"},
+  {"grasp", "GRASP"},
+  {"pipelined-grasp", "Pipelined GRASP"},
+  {"reactive-grasp", "Reactive GRASP"},
+  {"alns", "ALNS"},
+  {"penalized", "Penalized search"},
+  {"tabu", "Tabu search"},
+  {"sa", "SA"}
+};
+
+/*
+ * Print how to use the program.
+ *
+ * @param file    Output stream.
+ * @param program Name of the program.
+ */
+void print_usage(FILE *file, const char *program);
+
+/*
+ * Read the command line into a configuration, filling the defaults of the chosen engine.
+ *
+ * @param argc      Number of arguments.
+ * @param argv      Arguments.
+ * @param config    Configuration to be filled.
+ * @param instances Instance, directory or glob pattern given.
+ * @return          `false` if help was asked for.
+ * @throws std::invalid_argument If an option or its value is invalid.
+ */
+bool parse_command_line(int argc, char *argv[], Config &config, std::string &instances);
+
+/*
+ * Get the seed of a run, which depends on nothing but its instance and number, so that seeded batches are
+ * reproducible however their jobs are scheduled.
+ *
+ * @param seed     Seed given on the command line.
+ * @param instance Index of the instance in the batch, 0 if single.
+ * @param run      Index of the run.
+ * @return         Seed of the first thread of the run.
+ */
+unsigned int run_seed(unsigned int seed, int instance, int run);
+
+/*
+ * Solve an instance once, with the engine and parameters of the configuration.
+ *
+ * @param instance     Instance to be solved.
+ * @param config       Configuration.
+ * @param thread_count Number of threads of the engine, all available if less than one.
+ * @return             A Run object.
+ */
+Run solve(Instance &instance, const Config &config, int thread_count);
+
+/*
+ * Cost the initial and best solutions of a run with exact distances if it was solved with rounded travel times,
+ * which overestimate costs. Schedules are left as computed, as they stay feasible with shorter travel times.
+ *
+ * @param instance Instance solved by the run.
+ * @param run      The run.
+ */
+void recost(Instance &instance, Run &run);
+
+/*
+ * Get the instance files of a batch: every ".txt" file of a directory or every file matching a glob pattern.
+ *
+ * @param pattern A directory or a glob pattern.
+ * @return        Sorted file names.
+ */
+std::vector<std::string> get_instance_files(std::string pattern);
+
+/*
+ * Solve `config.runs` times every instance of a batch. All (instance, run) jobs share one pool of `config.threads`
+ * threads and are scheduled largest instance first, so that the longest jobs don't end up running alone at the
+ * end. Runs are written as they finish, followed by the statistics of every instance.
+ *
+ * @param files  Instance files.
+ * @param config Configuration.
+ * @return       Exit status.
+ */
+int solve_batch(std::vector<std::string> files, const Config &config);
+
+/*
+ * Write the members with the engine and parameters of the configuration.
+ *
+ * @param json   JSON writer, inside the outermost object.
+ * @param config Configuration.
+ */
+void write_parameters(JsonWriter &json, const Config &config);
+
+/*
+ * Write the members of a run: costs, execution information and the route of every vehicle with its schedule.
+ *
+ * @param json JSON writer, inside the object of the run.
+ * @param run  The run.
+ */
+void write_run(JsonWriter &json, const Run &run);
+
+/*
+ * Write the members with the statistics of the runs of an instance.
+ *
+ * @param json       JSON writer, inside the object of the instance.
+ * @param statistics Statistics of the runs.
+ */
+void write_statistics(JsonWriter &json, const Statistics &statistics);
+
+/*
+ * Write the members with the start and end dates of the computation.
  *
- * @param runs      A std::vector containing all runs.
- * @param file_name Name of the output file.
+ * @param json JSON writer, inside the outermost object.
  */
-void to_json(std::vector<Run> runs, std::string file_name);
+void write_dates(JsonWriter &json);
 
-int main(const int argc, const char* argv[])
+int main(int argc, char *argv[])
 {
-  const int min_args = 4, max_args = 4, args_given = argc - 1;
+  Config config;
+  std::string pattern;
 
-  if (args_given < min_args || args_given > max_args) {
-    fprintf(stderr, "Usage: %s <instance> <runs> <threads> <output json name> \n", argv[0]);
+  try {
+    if (!parse_command_line(argc, argv, config, pattern)) {
+      print_usage(stdout, argv[0]);
+      return EXIT_SUCCESS;
+    }
+  }
+  catch (const std::exception &e) {
+    fprintf(stderr, "%s\n", e.what());
+    print_usage(stderr, argv[0]);
     return EXIT_FAILURE;
   }
 
-  inst.init(argv[1]);
+  algorithms::set_time_limit(config.time_limit);
 
-  std::vector<Run> runs;
-  int num_runs = std::stoi(argv[2]);
+  struct stat st;
 
-  for (int i = 1; i <= num_runs; i++) {
-    // Run grasp_run = algorithms::grasp(2048, 0.2, std::stoi(argv[3]));
+  // Directories and glob patterns are solved as a batch
+  if ((stat(pattern.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) || pattern.find_first_of("*?[") != std::string::npos)
+    return solve_batch(get_instance_files(pattern), config);
 
-    // printf(
-    //   "GRASP run %d of %d ......... [c = %.2f, t = %.2fs]\n", i, num_runs, grasp_run.best.cost, grasp_run.elapsed_seconds
-    // );
+  Instance instance;
 
-    // runs.push_back(grasp_run);
+  try {
+    instance.init(pattern, config.use_cache, config.storage, config.travel_times_file, config.ordering);
+  }
+  catch (const std::exception &e) {
+    fprintf(stderr, "%s\n", e.what());
+    return EXIT_FAILURE;
+  }
 
-    Run ils_run = algorithms::ils(20000, 2500, 0.2);
+  std::unique_ptr<JsonWriter> json;
+
+  try {
+    json.reset(new JsonWriter(config.output));
+  }
+  catch (const std::exception &e) {
+    fprintf(stderr, "%s\n", e.what());
+    return EXIT_FAILURE;
+  }
+
+  std::string label;
+
+  for (auto pair : engines)
+    if (pair.first == config.engine)
+      label = pair.second;
+
+  Statistics statistics;
+
+  json->begin_object();
+  write_parameters(*json, config);
+  json->key("runs").begin_object();
+
+  for (int i = 1; i <= config.runs; i++) {
+    if (config.seeded)
+      algorithms::set_seed(run_seed(config.seed, 0, i - 1));
+
+    Run run = solve(instance, config, config.threads);
+    recost(instance, run);
 
     printf(
-      "ILS run %d of %d ......... [c = %.2f, t = %.2fs]\n", i, num_runs, ils_run.best.cost, ils_run.elapsed_seconds
+      "%s run %d of %d ......... [c = %.2f, t = %.2fs]\n", label.c_str(), i, config.runs, run.best.cost,
+      run.elapsed_seconds
     );
 
-    runs.push_back(ils_run);
+    json->key(std::to_string(i)).begin_object();
+    write_run(*json, run);
+    json->end_object().flush();
+
+    statistics.add(run, i);
   }
 
-  to_json(runs, argv[4]);
+  json->end_object();
+  write_statistics(*json, statistics);
+  write_dates(*json);
+  json->end_object();
 
   return EXIT_SUCCESS;
 }
 
-void to_json(std::vector<Run> runs, std::string file_name)
+void print_usage(FILE *file, const char *program)
 {
-  nlohmann::ordered_json j;
-  double best_cost, mean_cost = 0.0, mean_cpu = 0.0, standard_deviation = 0.0;
+  fprintf(file, "Usage: %s [options] <instance | directory | \"glob\">\n", program);
+  fprintf(file, "       %s <instance | directory | \"glob\"> <runs> <threads> <output json name>\n\n", program);
+  fprintf(file, "Engine:\n");
+  fprintf(file, "  -e, --engine NAME         ils, grasp, pipelined-grasp, reactive-grasp, alns, penalized, tabu or sa\n");
+  fprintf(file, "                            (default ils)\n");
+  fprintf(file, "  -i, --iterations N        iterations of every run (default 20000 for ils and penalized, 2048 for\n");
+  fprintf(file, "                            the GRASPs, 25000 for alns, 10000 for tabu, 1000000 for sa)\n");
+  fprintf(file, "  -n, --no-improvement N    iterations without improvement of ils and penalized (default 2500)\n");
+  fprintf(file, "  -T, --time-limit SECONDS  wall time limit of every run, whatever the iterations, exceeded\n"
+                "                            only to complete a first feasible solution (default none)\n");
+  fprintf(file, "  -a, --alpha A[,A...]      randomness of the constructive algorithm (default 0.2), or the candidate\n");
+  fprintf(file, "                            alphas of reactive-grasp (default 0.1,0.2,...,1.0)\n");
+  fprintf(file, "  -s, --seed N              make runs reproducible: thread t of the first run is seeded with N + t and\n");
+  fprintf(file, "                            every other run with a seed derived from N, its instance and number\n");
+  fprintf(file, "  -k, --regret K            routes ranked by the regret of the constructive algorithm (default 1)\n");
+  fprintf(file, "      --strategy S          best, first or sampled:N acceptance by the local search of ils\n");
+  fprintf(file, "                            (default best)\n");
+  fprintf(file, "      --pool N              route pool capacity of grasp, recombined in another thread (default 0)\n");
+  fprintf(file, "      --block-size N        iterations between alpha updates of reactive-grasp (default 256)\n");
+  fprintf(file, "      --tenure N            tabu tenure (default 7.5 log10 of the number of requests)\n");
+  fprintf(file, "      --cooling C           geometric or adaptive cooling of sa (default geometric)\n\n");
+  fprintf(file, "Execution:\n");
+  fprintf(file, "  -r, --runs N              runs of every instance (default 1)\n");
+  fprintf(file, "  -t, --threads N           threads of the engine, or of the job pool in a batch (default all)\n");
+  fprintf(file, "  -o, --output FILE         output JSON file (default out.json)\n\n");
+  fprintf(file, "Travel times:\n");
+  fprintf(file, "      --storage MODE        auto, dense, lazy, triangular, float32 or quantized (default auto)\n");
+  fprintf(file, "      --ordering ORDER      file, hilbert or time-window layout of the nodes (default file)\n");
+  fprintf(file, "      --travel-times FILE   binary travel time file, instead of Euclidean distances\n");
+  fprintf(file, "      --no-cache            neither read nor write the instance cache\n\n");
+  fprintf(file, "  -h, --help                print this message\n");
+}
 
-  for (int i = 0; i < runs.size(); i++) {
-    double value = runs[i].best.cost;
+/*
+ * Parse a whole integer, throwing an error that names the option otherwise.
+ */
+static int parse_int(const std::string &option, const char *value, int min)
+{
+  char *end;
+  errno = 0;
+  long number = strtol(value, &end, 10);
 
-    mean_cost += value;
-    mean_cpu += runs[i].elapsed_seconds;
+  if (errno || end == value || *end || number < min || number > INT_MAX)
+    throw std::invalid_argument("Invalid value '" + std::string(value) + "' of option " + option);
 
-    {
-      std::stringstream ss;
-      ss << std::setprecision(2) << std::fixed << runs[i].init.cost;
-      ss >> j["runs"][std::to_string(i + 1)]["init"];
+  return number;
+}
+
+/*
+ * Parse a whole non-negative real number, throwing an error that names the option otherwise.
+ */
+static double parse_double(const std::string &option, const char *value)
+{
+  char *end;
+  errno = 0;
+  double number = strtod(value, &end);
+
+  if (errno || end == value || *end || !(number >= 0.0))
+    throw std::invalid_argument("Invalid value '" + std::string(value) + "' of option " + option);
+
+  return number;
+}
+
+bool parse_command_line(int argc, char *argv[], Config &config, std::string &instances)
+{
+  enum {STRATEGY = 256, POOL, BLOCK_SIZE, TENURE, COOLING, STORAGE, ORDERING, TRAVEL_TIMES, NO_CACHE};
+
+  const struct option options[] = {
+    {"engine", required_argument, nullptr, 'e'},
+    {"iterations", required_argument, nullptr, 'i'},
+    {"no-improvement", required_argument, nullptr, 'n'},
+    {"time-limit", required_argument, nullptr, 'T'},
+    {"alpha", required_argument, nullptr, 'a'},
+    {"seed", required_argument, nullptr, 's'},
+    {"regret", required_argument, nullptr, 'k'},
+    {"strategy", required_argument, nullptr, STRATEGY},
+    {"pool", required_argument, nullptr, POOL},
+    {"block-size", required_argument, nullptr, BLOCK_SIZE},
+    {"tenure", required_argument, nullptr, TENURE},
+    {"cooling", required_argument, nullptr, COOLING},
+    {"runs", required_argument, nullptr, 'r'},
+    {"threads", required_argument, nullptr, 't'},
+    {"output", required_argument, nullptr, 'o'},
+    {"storage", required_argument, nullptr, STORAGE},
+    {"ordering", required_argument, nullptr, ORDERING},
+    {"travel-times", required_argument, nullptr, TRAVEL_TIMES},
+    {"no-cache", no_argument, nullptr, NO_CACHE},
+    {"help", no_argument, nullptr, 'h'},
+    {nullptr, 0, nullptr, 0}
+  };
+
+  // Errors are reported by the caller
+  opterr = 0;
+
+  for (int c, index = -1; (c = getopt_long(argc, argv, ":e:i:n:T:a:s:k:r:t:o:h", options, &index)) != -1; index = -1) {
+    // Name of the option as typed, for error messages
+    std::string option = index >= 0 ? std::string("--") + options[index].name : std::string("-") + (char) c;
+    std::string value = optarg ? optarg : "";
+
+    switch (c) {
+      case 'e': {
+        bool known = false;
+
+        for (auto pair : engines)
+          known = known || pair.first == value;
+
+        if (!known)
+          throw std::invalid_argument("Unknown engine '" + value + "'");
+
+        config.engine = value;
+        break;
+      }
+
+      case 'i':
+        config.iterations = parse_int(option, optarg, 1);
+        break;
+
+      case 'n':
+        config.no_improvement_iterations = parse_int(option, optarg, 1);
+        break;
+
+      case 'T':
+        config.time_limit = parse_double(option, optarg);
+        break;
+
+      case 'a':
+        config.alphas.clear();
+
+        for (size_t first = 0, last; first <= value.size(); first = last + 1) {
+          last = std::min(value.find(',', first), value.size());
+          config.alphas.push_back(parse_double(option, value.substr(first, last - first).c_str()));
+        }
+
+        break;
+
+      case 's':
+        config.seed = parse_int(option, optarg, 0);
+        config.seeded = true;
+        break;
+
+      case 'k':
+        config.regret_k = parse_int(option, optarg, 1);
+        break;
+
+      case STRATEGY:
+        if (value == "best")
+          config.strategy = algorithms::Strategy(algorithms::Strategy::Type::BEST_IMPROVEMENT);
+        else if (value == "first")
+          config.strategy = algorithms::Strategy(algorithms::Strategy::Type::FIRST_IMPROVEMENT);
+        else if (value.compare(0, 8, "sampled:") == 0)
+          config.strategy = algorithms::Strategy(
+            algorithms::Strategy::Type::SAMPLED, parse_int(option, value.c_str() + 8, 1)
+          );
+        else
+          throw std::invalid_argument("Unknown strategy '" + value + "'");
+
+        config.strategy_name = value;
+        break;
+
+      case POOL:
+        config.pool_capacity = parse_int(option, optarg, 0);
+        break;
+
+      case BLOCK_SIZE:
+        config.block_size = parse_int(option, optarg, 1);
+        break;
+
+      case TENURE:
+        config.tenure = parse_int(option, optarg, 1);
+        break;
+
+      case COOLING:
+        if (value == "geometric")
+          config.cooling = algorithms::Cooling::GEOMETRIC;
+        else if (value == "adaptive")
+          config.cooling = algorithms::Cooling::ADAPTIVE;
+        else
+          throw std::invalid_argument("Unknown cooling '" + value + "'");
+
+        break;
+
+      case 'r':
+        config.runs = parse_int(option, optarg, 1);
+        break;
+
+      case 't':
+        config.threads = parse_int(option, optarg, 0);
+        break;
+
+      case 'o':
+        config.output = value;
+        break;
+
+      case STORAGE: {
+        const std::vector<std::pair<std::string, TravelTimes::Mode>> modes = {
+          {"auto", TravelTimes::Mode::AUTO},
+          {"dense", TravelTimes::Mode::DENSE},
+          {"lazy", TravelTimes::Mode::LAZY},
+          {"triangular", TravelTimes::Mode::TRIANGULAR},
+          {"float32", TravelTimes::Mode::FLOAT32},
+          {"quantized", TravelTimes::Mode::QUANTIZED}
+        };
+
+        auto mode = std::find_if(modes.begin(), modes.end(), [&] (const std::pair<std::string, TravelTimes::Mode> &m) {
+          return m.first == value;
+        });
+
+        if (mode == modes.end())
+          throw std::invalid_argument("Unknown storage mode '" + value + "'");
+
+        config.storage = mode->second;
+        break;
+      }
+
+      case ORDERING:
+        if (value == "file")
+          config.ordering = Instance::Ordering::FILE;
+        else if (value == "hilbert")
+          config.ordering = Instance::Ordering::HILBERT;
+        else if (value == "time-window")
+          config.ordering = Instance::Ordering::TIME_WINDOW;
+        else
+          throw std::invalid_argument("Unknown ordering '" + value + "'");
+
+        break;
+
+      case TRAVEL_TIMES:
+        config.travel_times_file = value;
+        break;
+
+      case NO_CACHE:
+        config.use_cache = false;
+        break;
+
+      case 'h':
+        return false;
+
+      case ':':
+        throw std::invalid_argument("Missing value of option " + std::string(argv[optind - 1]));
+
+      default:
+        throw std::invalid_argument("Unknown option " + std::string(argv[optind - 1]));
     }
+  }
 
-    {
-      std::stringstream ss;
-      ss << std::setprecision(2) << std::fixed << runs[i].best.cost;
-      ss >> j["runs"][std::to_string(i + 1)]["best"];
+  std::vector<std::string> arguments(argv + optind, argv + argc);
+
+  // The former positional form stays valid: runs, threads and output file follow the instances
+  if (arguments.size() == 4) {
+    config.runs = parse_int("<runs>", arguments[1].c_str(), 1);
+    config.threads = parse_int("<threads>", arguments[2].c_str(), 0);
+    config.output = arguments[3];
+  }
+  else if (arguments.size() != 1) {
+    throw std::invalid_argument(arguments.empty() ? "Missing instance" : "Too many arguments");
+  }
+
+  instances = arguments[0];
+
+  if (config.alphas.empty())
+    config.alphas = config.engine == "reactive-grasp" ?
+                    std::vector<double>{0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9, 1.0} :
+                    std::vector<double>{0.2};
+  else if (config.alphas.size() > 1 && config.engine != "reactive-grasp")
+    throw std::invalid_argument("Only reactive-grasp takes several alphas");
+
+  if (config.iterations == 0) {
+    if (config.engine == "ils" || config.engine == "penalized")
+      config.iterations = 20000;
+    else if (config.engine == "alns")
+      config.iterations = 25000;
+    else if (config.engine == "tabu")
+      config.iterations = 10000;
+    else if (config.engine == "sa")
+      config.iterations = 1000000;
+    else
+      config.iterations = 2048;
+  }
+
+  return true;
+}
+
+unsigned int run_seed(unsigned int seed, int instance, int run)
+{
+  // Runs are far apart, leaving room for the consecutive seeds of the threads of every run
+  return seed + 1000003u * instance + 65537u * run;
+}
+
+Run solve(Instance &instance, const Config &config, int thread_count)
+{
+  double alpha = config.alphas.front();
+
+  if (config.engine == "grasp")
+    return algorithms::grasp(
+      instance, config.iterations, alpha, thread_count, config.regret_k, config.pool_capacity
+    );
+
+  if (config.engine == "pipelined-grasp") {
+    if (thread_count < 1 || thread_count > omp_get_max_threads())
+      thread_count = omp_get_max_threads();
+
+    // A constructor keeps about three local search threads busy
+    int constructor_count = std::max(1, thread_count/4);
+
+    return algorithms::pipelined_grasp(
+      instance, config.iterations, alpha, constructor_count, thread_count - constructor_count, 0.1, config.regret_k
+    );
+  }
+
+  if (config.engine == "reactive-grasp")
+    return algorithms::reactive_grasp(
+      instance, config.iterations, config.block_size, config.alphas, thread_count, 10.0, config.regret_k
+    );
+
+  if (config.engine == "alns")
+    return algorithms::alns(instance, config.iterations, 100, 0.1, 0.9997, 0.15, alpha);
+
+  if (config.engine == "penalized")
+    return algorithms::penalized_search(instance, config.iterations, config.no_improvement_iterations);
+
+  if (config.engine == "tabu") {
+    int tenure = config.tenure > 0 ? config.tenure : std::max(1, (int) round(7.5 * log10(instance.requests.size())));
+
+    return algorithms::tabu(instance, config.iterations, tenure, thread_count);
+  }
+
+  if (config.engine == "sa")
+    return algorithms::sa(instance, config.iterations, config.cooling, alpha);
+
+  return algorithms::ils(
+    instance, config.iterations, config.no_improvement_iterations, alpha, config.regret_k, config.strategy
+  );
+}
+
+void recost(Instance &instance, Run &run)
+{
+  if (!instance.travel_times.is_rounded())
+    return;
+
+  for (Solution *s : {&run.init, &run.best}) {
+    if (s->cost == FLT_MAX)
+      continue;
+
+    s->cost = 0.0;
+
+    for (auto &pair : s->routes) {
+      Route &route = pair.second;
+      route.cost = 0.0;
+
+      for (int i = 1; i < (int) route.path.size(); i++)
+        route.cost += instance.travel_times.get_exact(route.path[i - 1]->index, route.path[i]->index);
+
+      s->cost += route.cost;
     }
+  }
+}
 
-    {
-      std::stringstream ss;
-      ss << std::setprecision(2) << std::fixed << runs[i].best.routes.size();
-      ss >> j["runs"][std::to_string(i + 1)]["vehicles"];
+std::vector<std::string> get_instance_files(std::string pattern)
+{
+  std::vector<std::string> files;
+  struct stat st;
+
+  if (stat(pattern.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+    DIR *dir = opendir(pattern.c_str());
+
+    if (dir) {
+      for (struct dirent *entry = readdir(dir); entry; entry = readdir(dir)) {
+        std::string name = entry->d_name;
+
+        if (name.size() > 4 && name.compare(name.size() - 4, 4, ".txt") == 0)
+          files.push_back(pattern + '/' + name);
+      }
+
+      closedir(dir);
     }
+  }
+  else {
+    glob_t matches;
 
-    {
-      std::stringstream ss;
-      ss << std::setprecision(2) << std::fixed << runs[i].elapsed_seconds;
-      ss >> j["runs"][std::to_string(i + 1)]["cpu_time_in_seconds"];
+    if (glob(pattern.c_str(), 0, nullptr, &matches) == 0)
+      for (size_t i = 0; i < matches.gl_pathc; i++)
+        files.push_back(matches.gl_pathv[i]);
+
+    globfree(&matches);
+  }
+
+  std::sort(files.begin(), files.end());
+
+  return files;
+}
+
+int solve_batch(std::vector<std::string> files, const Config &config)
+{
+  if (files.empty()) {
+    fprintf(stderr, "No instances found\n");
+    return EXIT_FAILURE;
+  }
+
+  // A travel time file matches the nodes of a single instance
+  if (!config.travel_times_file.empty()) {
+    fprintf(stderr, "A travel time file can't be given to a batch\n");
+    return EXIT_FAILURE;
+  }
+
+  std::unique_ptr<JsonWriter> json;
+
+  try {
+    json.reset(new JsonWriter(config.output));
+  }
+  catch (const std::exception &e) {
+    fprintf(stderr, "%s\n", e.what());
+    return EXIT_FAILURE;
+  }
+
+  std::vector<Instance*> instances;
+
+  for (std::string file : files) {
+    instances.push_back(new Instance());
+
+    try {
+      instances.back()->init(file, config.use_cache, config.storage, "", config.ordering);
     }
+    catch (const std::exception &e) {
+      fprintf(stderr, "%s\n", e.what());
 
-    j["runs"][std::to_string(i + 1)]["feasible"] = runs[i].best.feasible();
-    j["runs"][std::to_string(i + 1)]["threads"] = runs[i].seeds.size();
-    j["runs"][std::to_string(i + 1)]["seeds"] = runs[i].seeds;
+      for (Instance *instance : instances)
+        delete instance;
 
-    if (i == 0 || value < best_cost) {
-      j["best_run"] = i + 1;
-      best_cost = value;
+      return EXIT_FAILURE;
     }
   }
 
-  mean_cost /= runs.size();
-  mean_cpu /= runs.size();
+  // Jobs are pairs (instance, run), the largest instances go first
+  std::vector<std::pair<int, int>> jobs;
 
-  for (int i = 0; i < runs.size(); i++)
-    standard_deviation += pow(runs[i].best.cost - mean_cost, 2);
+  for (int i = 0; i < (int) instances.size(); i++)
+    for (int k = 0; k < config.runs; k++)
+      jobs.push_back({i, k});
 
-  if (runs.size() > 1)
-    standard_deviation = sqrt(standard_deviation/(runs.size() - 1));
+  std::stable_sort(jobs.begin(), jobs.end(), [&] (const std::pair<int, int> &j1, const std::pair<int, int> &j2) {
+    return instances[j1.first]->requests.size() > instances[j2.first]->requests.size();
+  });
 
-  {
-    std::stringstream ss;
-    ss << std::setprecision(2) << std::fixed << best_cost;
-    ss >> j["best_cost"];
+  int num_threads = config.threads;
+
+  if (num_threads < 1 || num_threads > omp_get_max_threads())
+    num_threads = omp_get_max_threads();
+
+  std::vector<Statistics> statistics(instances.size());
+  int done = 0;
+  double start = omp_get_wtime();
+
+  json->begin_object();
+  write_parameters(*json, config);
+  json->key("runs").begin_array();
+
+  // Solvers don't nest parallel regions inside the pool, so every job runs in a single thread
+  #pragma omp parallel for schedule(dynamic, 1) num_threads(num_threads)
+  for (int j = 0; j < (int) jobs.size(); j++) {
+    Instance *instance = instances[jobs[j].first];
+
+    // Seeds are set per thread of the pool
+    if (config.seeded)
+      algorithms::set_seed(run_seed(config.seed, jobs[j].first, jobs[j].second));
+
+    Run run = solve(*instance, config, 1);
+    recost(*instance, run);
+
+    // Runs are written in the order they finish, each one flushed so that a crash doesn't lose it
+    #pragma omp critical
+    {
+      printf(
+        "[%3d/%3zu] %-6s run %d ......... [c = %.2f, t = %.2fs]\n", ++done, jobs.size(), instance->name.c_str(),
+        jobs[j].second + 1, run.best.cost, run.elapsed_seconds
+      );
+
+      json->begin_object();
+      json->key("instance").value(instance->name);
+      json->key("run").value(jobs[j].second + 1);
+      write_run(*json, run);
+      json->end_object().flush();
+
+      statistics[jobs[j].first].add(run, jobs[j].second + 1);
+    }
   }
 
-  {
-    std::stringstream ss;
-    ss << std::setprecision(2) << std::fixed << mean_cost;
-    ss >> j["mean_cost"];
+  json->end_array().key("instances").begin_object();
+
+  for (int i = 0; i < (int) instances.size(); i++) {
+    json->key(instances[i]->name).begin_object();
+    write_statistics(*json, statistics[i]);
+    json->end_object();
   }
 
-  {
-    std::stringstream ss;
-    ss << std::setprecision(2) << std::fixed << standard_deviation;
-    ss >> j["cost_standard_deviation"];
+  json->end_object();
+  json->key("elapsed_seconds").value(omp_get_wtime() - start);
+  json->key("threads").value(num_threads);
+  write_dates(*json);
+  json->end_object();
+
+  for (Instance *instance : instances)
+    delete instance;
+
+  return EXIT_SUCCESS;
+}
+
+void write_parameters(JsonWriter &json, const Config &config)
+{
+  json.key("engine").value(config.engine);
+  json.key("iterations").value(config.iterations);
+
+  if (config.engine == "ils" || config.engine == "penalized")
+    json.key("no_improvement_iterations").value(config.no_improvement_iterations);
+
+  if (config.time_limit > 0.0)
+    json.key("time_limit_in_seconds").value(config.time_limit);
+
+  json.key("alphas").begin_array();
+
+  for (double alpha : config.alphas)
+    json.value(alpha);
+
+  json.end_array();
+
+  if (config.seeded)
+    json.key("seed").value(config.seed);
+
+  json.key("regret_k").value(config.regret_k);
+
+  if (config.engine == "ils")
+    json.key("strategy").value(config.strategy_name);
+}
+
+void write_run(JsonWriter &json, const Run &run)
+{
+  // Costs of solutions never found are null rather than FLT_MAX
+  bool found = run.best.cost < FLT_MAX;
+
+  if (run.init.cost < FLT_MAX)
+    json.key("init").value(run.init.cost);
+  else
+    json.key("init").null();
+
+  if (found)
+    json.key("best").value(run.best.cost);
+  else
+    json.key("best").null();
+
+  json.key("vehicles").value((int) run.best.routes.size());
+  json.key("cpu_time_in_seconds").value(run.elapsed_seconds);
+  json.key("feasible").value(found && run.best.feasible());
+  json.key("threads").value((int) run.seeds.size());
+  json.key("seeds").begin_array();
+
+  for (unsigned int seed : run.seeds)
+    json.value(seed);
+
+  json.end_array();
+
+  // Only Reactive GRASP runs carry alpha statistics
+  if (!run.alphas.empty()) {
+    json.key("best_iteration").value(run.best_iteration);
+    json.key("best_alpha").value(run.best_alpha);
+    json.key("alphas").begin_object();
+
+    for (auto pair : run.alphas) {
+      char alpha[32];
+      snprintf(alpha, sizeof(alpha), "%.2f", pair.first);
+
+      json.key(alpha).begin_object();
+      json.key("probability").value(pair.second.probability, 4);
+      json.key("avg").value(pair.second.avg());
+      json.key("count").value(pair.second.count);
+      json.end_object();
+    }
+
+    json.end_object();
   }
 
-  {
-    std::stringstream ss;
-    ss << std::setprecision(2) << std::fixed << mean_cpu;
-    ss >> j["mean_cpu_time_in_seconds"];
+  // Routes are written by vehicle id, nodes by their id in the instance file
+  std::vector<const Route*> routes;
+
+  for (auto &pair : run.best.routes)
+    routes.push_back(&pair.second);
+
+  std::sort(routes.begin(), routes.end(), [] (const Route *r1, const Route *r2) {
+    return r1->vehicle->id < r2->vehicle->id;
+  });
+
+  json.key("routes").begin_array();
+
+  for (const Route *r : routes) {
+    json.begin_object();
+    json.key("vehicle").value(r->vehicle->id);
+    json.key("cost").value(r->cost);
+    json.key("schedule").begin_array();
+
+    for (int i = 0; i < (int) r->path.size(); i++) {
+      json.begin_object();
+      json.key("node").value(r->path[i]->id);
+      json.key("load").value(r->load[i]);
+      json.key("arrival").value(r->arrival_times[i]);
+      json.key("service_beginning").value(r->service_beginning_times[i]);
+      json.key("departure").value(r->departure_times[i]);
+      json.end_object();
+    }
+
+    json.end_array();
+    json.end_object();
   }
 
-  j["start_date"] = std::ctime(&now);
-  now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
-  j["end_date"] = std::ctime(&now);
+  json.end_array();
+}
 
-  // Write prettified JSON to another file
-  std::ofstream out(file_name);
-  out << std::setw(4) << j << std::endl;
+void write_statistics(JsonWriter &json, const Statistics &statistics)
+{
+  if (statistics.solved > 0) {
+    json.key("best_run").value(statistics.best_run);
+    json.key("best_cost").value(statistics.best_cost);
+    json.key("mean_cost").value(statistics.mean_cost);
+    json.key("cost_standard_deviation").value(statistics.standard_deviation());
+  }
+  else {
+    json.key("best_run").null();
+    json.key("best_cost").null();
+    json.key("mean_cost").null();
+    json.key("cost_standard_deviation").null();
+  }
+
+  json.key("solved_runs").value(statistics.solved);
+  json.key("mean_cpu_time_in_seconds").value(statistics.mean_cpu);
+}
+
+void write_dates(JsonWriter &json)
+{
+  json.key("start_date").value(std::ctime(&now));
+  now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+  json.key("end_date").value(std::ctime(&now));
 }
@@ -9,6 +9,7 @@
 Node::Node(int id)
 {
   this->id = id;
+  this->index = id;
 }
 
 bool Node::is_pickup()
@@ -0,0 +1,368 @@
+/**
+ * @file   penalized_search.cpp
+ * @author Diego Paiva
+ * @date   18/10/2026
+ */
+
+#include "algorithms.hpp"
+#include "instance.hpp"
+
+#include <cfloat>    // FLT_MAX
+#include <algorithm> // std::min, std::max, std::sort
+#include <tuple>     // std::tuple, std::make_tuple, std::get
+#include <omp.h>     // omp_get_wtime
+
+namespace algorithms
+{
+  using namespace details;
+
+  Run penalized_search(Instance &instance, int max_iterations, int no_improvement_iterations, double adjustment,
+                       double max_removal)
+  {
+    Run run;
+    double start = omp_get_wtime();
+
+    // Seed the Random engine of each thread, from std::random_device unless a seed was set
+    unsigned int seed = get_seed();
+    Random::seed(seed);
+    run.seeds.push_back(seed);
+
+    Penalty penalty;
+    // If abandoned at the deadline, the search doesn't start and a solution is built the usual way instead
+    Solution curr = construct_penalized_solution(instance, penalty, get_deadline(start));
+    std::vector<Request*> requests = instance.requests;
+
+    // The penalized construction is rarely feasible, so the initial solution is the first feasible one reached
+    run.init.cost = FLT_MAX;
+    run.best.cost = FLT_MAX;
+
+    int max_q = std::max(1, (int) (max_removal * instance.requests.size()));
+
+    for (int it = 0, n = 0; it < max_iterations && n < no_improvement_iterations && !out_of_time(start); it++) {
+      curr = penalized_descent(curr, penalty, get_deadline(start));
+
+      if (!violated(curr)) {
+        if (run.init.cost == FLT_MAX)
+          run.init = curr;
+
+        // Feasible routes are evaluated the same way with or without early exit, so the usual operators apply
+        curr = vnd(curr, false, Strategy(), get_deadline(start));
+
+        if (curr.cost < run.best.cost) {
+          run.best = curr;
+          run.convergence.push_back({omp_get_wtime() - start, run.best.cost});
+          n = 0;
+        }
+        else {
+          n++;
+        }
+      }
+      else {
+        n++;
+      }
+
+      penalty.update(curr, adjustment);
+
+      // Perturbation: relocate a few random requests to random routes
+      std::unordered_map<Request*, Vehicle*, RequestHash> assignments = get_assignments(curr);
+      Random::shuffle(requests);
+
+      for (int i = 0, q = Random::get(1, max_q); i < q; i++) {
+        Request *req = requests[i];
+        Route r = curr.routes[assignments[req]];
+
+        r.erase_request(req);
+        r.evaluate(false);
+        curr.add_route(r);
+
+        // Every vehicle of the instance has a route, so vehicles are picked in their order rather than the routes'
+        Vehicle *v = *Random::get(instance.vehicles);
+        curr.add_route(get_cheapest_penalized_insertion(req, curr.routes[v], penalty));
+        assignments[req] = v;
+      }
+    }
+
+    // No feasible solution was reached, e.g. within few iterations or the time limit, so one is built the usual way
+    if (run.best.cost == FLT_MAX) {
+      do {
+        run.init = construct_greedy_randomized_solution(instance, 0.2);
+
+        if (!run.init.feasible())
+          run.init = repair(run.init);
+      }
+      while (!run.init.feasible());
+
+      run.best = vnd(run.init, false, Strategy(), get_deadline(start));
+      run.convergence.push_back({omp_get_wtime() - start, run.best.cost});
+    }
+
+    run.init.delete_empty_routes();
+    run.best.delete_empty_routes();
+
+    double finish = omp_get_wtime();
+    run.elapsed_seconds = finish - start;
+
+    return run;
+  }
+
+  namespace details
+  {
+    /*
+     * Any violation is worth at least one unit, otherwise round-off sized violations would never be fixed.
+     */
+    double units(double violation)
+    {
+      return violation > 0.0 ? std::max(violation, 1.0) : 0.0;
+    }
+
+    double Penalty::cost(const Route &r) const
+    {
+      return r.cost + load * units(r.load_violation) + time_window * units(r.time_window_violation) +
+             ride_time * units(r.max_ride_time_violation) + route_duration * units(r.max_route_duration_violation);
+    }
+
+    double Penalty::cost(const Solution &s) const
+    {
+      double penalized_cost = 0.0;
+
+      for (auto &pair : s.routes)
+        penalized_cost += cost(pair.second);
+
+      return penalized_cost;
+    }
+
+    void Penalty::update(const Solution &s, double adjustment)
+    {
+      double violations[4] = {0.0, 0.0, 0.0, 0.0};
+      double *weights[4] = {&load, &time_window, &ride_time, &route_duration};
+
+      for (auto &pair : s.routes) {
+        violations[0] += pair.second.load_violation;
+        violations[1] += pair.second.time_window_violation;
+        violations[2] += pair.second.max_ride_time_violation;
+        violations[3] += pair.second.max_route_duration_violation;
+      }
+
+      for (int i = 0; i < 4; i++) {
+        if (violations[i] > 0.0)
+          *weights[i] *= 1 + adjustment;
+        else
+          *weights[i] /= 1 + adjustment;
+
+        // Keep weights bounded, otherwise a long streak of (in)feasible iterations would overflow them
+        *weights[i] = std::min(std::max(*weights[i], 1e-3), 1e6);
+      }
+    }
+
+    Solution construct_penalized_solution(Instance &instance, const Penalty &penalty, double deadline)
+    {
+      Solution s(&instance);
+
+      for (Vehicle *v : instance.vehicles) {
+        Route r(&instance, v);
+        r.path.push_back(instance.get_depot());
+        r.path.push_back(instance.get_depot());
+        r.evaluate(false);
+        s.add_route(r);
+      }
+
+      std::vector<Request*> requests = instance.requests;
+      Random::shuffle(requests);
+
+      // Every request goes to its position of least penalized cost, so no extra vehicle is ever activated
+      for (Request *req : requests) {
+        if (omp_get_wtime() >= deadline) {
+          s.cost = FLT_MAX;
+          return s;
+        }
+
+        Route best;
+        double delta = FLT_MAX;
+
+        for (auto &pair : s.routes) {
+          Route r = get_cheapest_penalized_insertion(req, pair.second, penalty);
+
+          if (penalty.cost(r) - penalty.cost(pair.second) < delta) {
+            delta = penalty.cost(r) - penalty.cost(pair.second);
+            best = r;
+          }
+        }
+
+        s.add_route(best);
+      }
+
+      return s;
+    }
+
+    bool violated(const Route &r)
+    {
+      return r.load_violation > 0 || r.time_window_violation > 0.0 ||
+             r.max_ride_time_violation > 0.0 || r.max_route_duration_violation > 0.0;
+    }
+
+    bool violated(const Solution &s)
+    {
+      for (auto &pair : s.routes)
+        if (violated(pair.second))
+          return true;
+
+      return false;
+    }
+
+    Route get_cheapest_penalized_insertion(Request *req, Route r, const Penalty &penalty, double bound)
+    {
+      Instance &instance = *r.instance;
+      int n = r.path.size(), q = req->pickup->load, capacity = r.vehicle->capacity;
+
+      // Lower bound on the penalized cost of each position, as (bound, pickup index, delivery index)
+      std::vector<std::tuple<double, int, int>> positions;
+
+      // Earliest service beginning times, loads and prefix sums of their violations along the path with the pickup
+      std::vector<double> earliest(n + 1), time_window(n + 1, 0.0), load(n + 1, 0.0), load_delivered(n + 1, 0.0);
+      std::vector<int> loads(n + 1, 0);
+
+      auto departure = [&] (int i) {
+        return i == 0 ? earliest[0] : earliest[i] + r.path[i]->service_time;
+      };
+
+      for (int p = 1; p < n; p++) {
+        r.insert_node(req->pickup, p);
+
+        earliest[0] = r.path[0]->arrival_time;
+
+        for (int i = 1; i <= n; i++) {
+          earliest[i] = std::max(r.path[i]->arrival_time,
+                                 departure(i - 1) + instance.get_travel_time(r.path[i - 1], r.path[i]));
+          loads[i] = loads[i - 1] + r.path[i]->load;
+          time_window[i] = time_window[i - 1] + std::max(0.0, earliest[i] - r.path[i]->departure_time);
+          load[i] = load[i - 1] + std::max(0, loads[i] - capacity);
+          load_delivered[i] = load_delivered[i - 1] + std::max(0, loads[i] - q - capacity);
+        }
+
+        for (int d = p + 1; d <= n; d++) {
+          Node *prev = r.path[d - 1];
+          double cost = r.cost + instance.get_travel_time(prev, req->delivery)
+                               + instance.get_travel_time(req->delivery, r.path[d])
+                               - instance.get_travel_time(prev, r.path[d]);
+
+          if (cost >= bound)
+            continue;
+
+          // The load is exact, since the delivery only lowers it on the remaining nodes
+          double load_violation = load[d - 1] + load_delivered[n] - load_delivered[d - 1];
+
+          // Service can only begin later than the earliest times, so their violations bound the schedule's from
+          // below. Past the delivery, they are propagated until they meet those of the path without it
+          double time = std::max(req->delivery->arrival_time,
+                                 departure(d - 1) + instance.get_travel_time(prev, req->delivery));
+          double time_window_violation = time_window[d - 1] + std::max(0.0, time - req->delivery->departure_time);
+          int i = d;
+
+          for (prev = req->delivery; i <= n; prev = r.path[i], i++) {
+            time = std::max(r.path[i]->arrival_time,
+                            time + prev->service_time + instance.get_travel_time(prev, r.path[i]));
+
+            if (time <= earliest[i])
+              break;
+
+            time_window_violation += std::max(0.0, time - r.path[i]->departure_time);
+          }
+
+          if (i <= n)
+            time_window_violation += time_window[n] - time_window[i - 1];
+
+          cost += penalty.load * units(load_violation) + penalty.time_window * units(time_window_violation);
+
+          if (cost < bound)
+            positions.push_back(std::make_tuple(cost, p, d));
+        }
+
+        r.erase_node(p);
+      }
+
+      std::sort(positions.begin(), positions.end());
+
+      Route best;
+      double best_cost = bound;
+
+      best.cost = FLT_MAX;
+
+      // Only positions whose bound beats the best so far are evaluated, most promising first
+      for (auto &position : positions) {
+        if (std::get<0>(position) >= best_cost)
+          break;
+
+        Route curr = r;
+        curr.insert_node(req->pickup, std::get<1>(position));
+        curr.insert_node(req->delivery, std::get<2>(position));
+        curr.evaluate(false);
+
+        if (penalty.cost(curr) < best_cost) {
+          best_cost = penalty.cost(curr);
+          best = curr;
+        }
+      }
+
+      return best;
+    }
+
+    Solution penalized_descent(Solution s, const Penalty &penalty, double deadline)
+    {
+      Instance &instance = *s.instance;
+      std::vector<Request*> requests = instance.requests;
+      std::unordered_map<Request*, Vehicle*, RequestHash> assignments = get_assignments(s);
+      bool improved;
+
+      do {
+        improved = false;
+        Random::shuffle(requests);
+
+        for (Request *req : requests) {
+          if (omp_get_wtime() >= deadline)
+            return s;
+
+          Vehicle *v1 = assignments[req];
+          Route r1 = s.routes[v1];
+
+          r1.erase_request(req);
+          r1.evaluate(false);
+
+          // Penalized gain of removing the request from its current route
+          double removal = penalty.cost(r1) - penalty.cost(s.routes[v1]);
+
+          Route best;
+          double delta = -1e-6;
+
+          for (auto &pair : s.routes) {
+            const Route &r2 = pair.first == v1 ? r1 : pair.second;
+
+            // Only insertions improving on the best relocation so far are of interest
+            Route new_r2 = get_cheapest_penalized_insertion(req, r2, penalty, delta - removal + penalty.cost(r2));
+
+            if (!new_r2.feasible())
+              continue;
+
+            double curr = removal + penalty.cost(new_r2) - penalty.cost(r2);
+
+            if (curr < delta) {
+              delta = curr;
+              best = new_r2;
+            }
+          }
+
+          if (delta < -1e-6) {
+            if (best.vehicle != v1)
+              s.add_route(r1);
+
+            s.add_route(best);
+            assignments[req] = best.vehicle;
+            improved = true;
+          }
+        }
+      }
+      while (improved);
+
+      return s;
+    }
+  } // namespace details
+} // namespace algorithms
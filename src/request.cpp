@@ -7,20 +7,22 @@
 #include "request.hpp"
 #include "instance.hpp"
 
-Request::Request(Node *pickup, Node *delivery)
+Request::Request(Instance *instance, Node *pickup, Node *delivery, bool tighten)
 {
   this->pickup = pickup;
   this->delivery = delivery;
-  tighten_time_windows(pickup->max_ride_time);
+
+  if (tighten)
+    tighten_time_windows(instance, pickup->max_ride_time);
 }
 
-void Request::tighten_time_windows(double max_ride_time, double planning_horizon)
+void Request::tighten_time_windows(Instance *instance, double max_ride_time, double planning_horizon)
 {
   bool inbound = pickup->departure_time - pickup->arrival_time == planning_horizon ? false : true;
 
   if (inbound) {
     delivery->arrival_time = std::max(
-      0.0, pickup->arrival_time + pickup->service_time + inst.get_travel_time(pickup, delivery)
+      0.0, pickup->arrival_time + pickup->service_time + instance->get_travel_time(pickup, delivery)
     );
 
     delivery->departure_time = std::min(
@@ -33,7 +35,7 @@ void Request::tighten_time_windows(double max_ride_time, double planning_horizon
     );
 
     pickup->departure_time = std::min(
-      delivery->departure_time - inst.get_travel_time(pickup, delivery) - pickup->service_time, planning_horizon
+      delivery->departure_time - instance->get_travel_time(pickup, delivery) - pickup->service_time, planning_horizon
     );
   }
 }
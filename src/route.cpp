@@ -14,11 +14,13 @@
 Route::Route()
 {
   this->cost = 0.0;
+  this->instance = nullptr;
 }
 
-Route::Route(Vehicle *vehicle)
+Route::Route(Instance *instance, Vehicle *vehicle)
 {
   this->cost = 0.0;
+  this->instance = instance;
   this->vehicle = vehicle;
 }
 
@@ -42,11 +44,11 @@ double Route::get_earliest_time(int i)
   else
     return std::max(
       path[i]->arrival_time,
-      get_earliest_time(i - 1) + path[i - 1]->service_time + inst.get_travel_time(path[i - 1], path[i])
+      get_earliest_time(i - 1) + path[i - 1]->service_time + instance->get_travel_time(path[i - 1], path[i])
     );
 }
 
-bool Route::evaluate()
+bool Route::evaluate(bool early_exit)
 {
   int size = path.size();
 
@@ -76,14 +78,14 @@ bool Route::evaluate()
     compute_load(i);
 
     // Violated vehicle capacity, which is an irreparable violation
-    if (load[i] > vehicle->capacity)
+    if (early_exit && load[i] > vehicle->capacity)
       goto STEP8;
 
     compute_arrival_time(i);
     compute_service_beginning_time(i);
 
     // Violated time window, which is an irreparable violation
-    if (service_beginning_times[i] > path[i]->departure_time)
+    if (early_exit && service_beginning_times[i] > path[i]->departure_time)
       goto STEP8;
 
     compute_waiting_time(i);
@@ -140,7 +142,7 @@ bool Route::evaluate()
       // STEP 7 (d):
       for (int i = j + 1; i < path.size() - 1; i++)
         if (path[i]->is_delivery())
-          compute_ride_time(nodes_indices[inst.get_request(path[i])->pickup]);
+          compute_ride_time(nodes_indices[instance->get_request(path[i])->pickup]);
     }
   }
 
@@ -151,7 +153,7 @@ bool Route::evaluate()
   max_ride_time_violation = 0.0;
 
   for (int i = 1; i < path.size(); i++) {
-    cost += inst.get_travel_time(path[i - 1], path[i]);
+    cost += instance->get_travel_time(path[i - 1], path[i]);
     load_violation += std::max(0, load[i] - vehicle->capacity);
     time_window_violation += std::max(0.0, service_beginning_times[i] - path[i]->departure_time);
     max_route_duration_violation = std::max(0.0, duration() - vehicle->max_route_duration);
@@ -169,14 +171,19 @@ double Route::get_forward_time_slack(int i)
 {
   double min_time_slack = FLT_MAX;
 
+  // Total waiting time between i and j, kept as a running sum instead of being accumulated for every j
+  double waiting_time = 0.0;
+
   for (int j = i; j < path.size(); j++) {
     double pj = 0.0;
 
-    if (path[j]->is_delivery() && nodes_indices[inst.get_request(path[j])->pickup] < i)
-      pj = ride_times[nodes_indices[inst.get_request(path[j])->pickup]];
+    if (j > i)
+      waiting_time += waiting_times[j];
+
+    if (path[j]->is_delivery() && nodes_indices[instance->get_request(path[j])->pickup] < i)
+      pj = ride_times[nodes_indices[instance->get_request(path[j])->pickup]];
 
-    double time_slack = std::accumulate(waiting_times.begin() + i + 1, waiting_times.begin() + j + 1, 0.0) +
-                        std::max(0.0, std::min(path[j]->departure_time - service_beginning_times[j], 90.0 - pj));
+    double time_slack = waiting_time + std::max(0.0, std::min(path[j]->departure_time - service_beginning_times[j], 90.0 - pj));
 
     if (time_slack < min_time_slack)
       min_time_slack = time_slack;
@@ -201,7 +208,7 @@ void Route::compute_load(int i)
 
 void Route::compute_arrival_time(int i)
 {
-  arrival_times[i] = departure_times[i - 1] + inst.get_travel_time(path[i - 1], path[i]);
+  arrival_times[i] = departure_times[i - 1] + instance->get_travel_time(path[i - 1], path[i]);
 }
 
 void Route::compute_service_beginning_time(int i)
@@ -221,7 +228,7 @@ void Route::compute_departure_time(int i)
 
 void Route::compute_ride_time(int i)
 {
-  ride_times[i] = service_beginning_times[nodes_indices[inst.get_request(path[i])->delivery]] - departure_times[i];
+  ride_times[i] = service_beginning_times[nodes_indices[instance->get_request(path[i])->delivery]] - departure_times[i];
 }
 
 double Route::duration()
@@ -235,9 +242,9 @@ void Route::insert_node(Node *node, int index)
     path.insert(path.begin() + index, node);
 
     // Recalculate route's total cost
-    cost = cost + inst.get_travel_time(path[index - 1], path[index])
-                + inst.get_travel_time(path[index], path[index + 1])
-                - inst.get_travel_time(path[index - 1], path[index + 1]);
+    cost = cost + instance->get_travel_time(path[index - 1], path[index])
+                + instance->get_travel_time(path[index], path[index + 1])
+                - instance->get_travel_time(path[index - 1], path[index + 1]);
   }
 }
 
@@ -245,9 +252,9 @@ void Route::erase_node(int index)
 {
   if (index > 0 && index < path.size() - 1) {
     // Recalculate route's total cost
-    cost = cost - inst.get_travel_time(path[index - 1], path[index])
-                - inst.get_travel_time(path[index], path[index + 1])
-                + inst.get_travel_time(path[index - 1], path[index + 1]);
+    cost = cost - instance->get_travel_time(path[index - 1], path[index])
+                - instance->get_travel_time(path[index], path[index + 1])
+                + instance->get_travel_time(path[index - 1], path[index + 1]);
 
     path.erase(path.begin() + index);
   }
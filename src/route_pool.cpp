@@ -0,0 +1,152 @@
+/**
+ * @file   route_pool.cpp
+ * @author Diego Paiva
+ * @date   18/10/2026
+ */
+
+#include "route_pool.hpp"
+#include "algorithms.hpp"
+#include "instance.hpp"
+
+#include <cfloat>    // FLT_MAX
+#include <algorithm> // std::sort
+
+RoutePool::RoutePool(Instance &instance, int capacity) : instance(&instance), capacity(capacity), version(0)
+{
+}
+
+bool RoutePool::add(const Route &r)
+{
+  Entry entry;
+  entry.route = r;
+
+  for (Node *node : r.path)
+    if (node->is_pickup())
+      entry.requests.push_back(node->id - 1);
+
+  if (entry.requests.empty())
+    return false;
+
+  std::sort(entry.requests.begin(), entry.requests.end());
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  // Routes are identified by the set of requests they serve
+  auto it = entries.find(entry.requests);
+
+  if (it != entries.end()) {
+    if (it->second.route.cost <= r.cost)
+      return false;
+
+    it->second = entry;
+    version++;
+
+    return true;
+  }
+
+  if ((int) entries.size() >= capacity) {
+    auto worst = entries.begin();
+
+    for (auto it = entries.begin(); it != entries.end(); it++)
+      if (it->second.route.cost/it->second.requests.size() > worst->second.route.cost/worst->second.requests.size())
+        worst = it;
+
+    if (worst->second.route.cost/worst->second.requests.size() <= r.cost/entry.requests.size())
+      return false;
+
+    entries.erase(worst);
+  }
+
+  entries[entry.requests] = entry;
+  version++;
+
+  return true;
+}
+
+void RoutePool::add(const Solution &s)
+{
+  for (auto &pair : s.routes)
+    add(pair.second);
+}
+
+int RoutePool::size()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return entries.size();
+}
+
+Solution RoutePool::recombine(int attempts, double noise)
+{
+  std::vector<Entry> pool;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (auto &pair : entries)
+      pool.push_back(pair.second);
+  }
+
+  Solution best(instance);
+  best.cost = FLT_MAX;
+
+  for (int attempt = 0; attempt < attempts; attempt++) {
+    std::vector<std::pair<double, int>> order;
+
+    for (int i = 0; i < (int) pool.size(); i++) {
+      double ratio = pool[i].route.cost/pool[i].requests.size();
+
+      if (attempt > 0)
+        ratio *= algorithms::details::Random::get(1.0, 1.0 + noise);
+
+      order.push_back({ratio, i});
+    }
+
+    std::sort(order.begin(), order.end());
+
+    std::vector<bool> covered(instance->requests.size(), false);
+    Solution s(instance);
+    int k = 0;
+
+    for (auto &pair : order) {
+      if (k == (int) instance->vehicles.size())
+        break;
+
+      const Entry &entry = pool[pair.second];
+      bool disjoint = true;
+
+      for (int i : entry.requests)
+        if (covered[i])
+          disjoint = false;
+
+      if (!disjoint)
+        continue;
+
+      for (int i : entry.requests)
+        covered[i] = true;
+
+      // The fleet is homogeneous, so routes can be handed to any vehicle
+      Route r = entry.route;
+      r.vehicle = instance->vehicles[k++];
+      s.add_route(r);
+    }
+
+    for (; k < (int) instance->vehicles.size(); k++) {
+      Route r(instance, instance->vehicles[k]);
+      r.path.push_back(instance->get_depot());
+      r.path.push_back(instance->get_depot());
+      r.evaluate();
+      s.add_route(r);
+    }
+
+    std::vector<Request*> uncovered;
+
+    for (int i = 0; i < (int) covered.size(); i++)
+      if (!covered[i])
+        uncovered.push_back(instance->requests[i]);
+
+    if (algorithms::details::insert_requests(s, uncovered, 0.0, 1, false) && s.cost < best.cost)
+      best = s;
+  }
+
+  return best;
+}
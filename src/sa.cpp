@@ -0,0 +1,338 @@
+/**
+ * @file   sa.cpp
+ * @author Diego Paiva
+ * @date   18/10/2026
+ */
+
+#include "algorithms.hpp"
+#include "instance.hpp"
+
+#include <cmath>     // exp, log, pow
+#include <algorithm> // std::max
+#include <omp.h>     // omp_get_wtime
+
+namespace algorithms
+{
+  namespace details
+  {
+    /*
+     * Travel cost delta of removing the nodes at positions `p` < `d` of route `r`.
+     */
+    double removal_delta(const Route &r, int p, int d)
+    {
+      Instance &instance = *r.instance;
+      const std::vector<Node*> &path = r.path;
+
+      if (d == p + 1)
+        return instance.get_travel_time(path[p - 1], path[d + 1]) - instance.get_travel_time(path[p - 1], path[p]) -
+               instance.get_travel_time(path[p], path[d]) - instance.get_travel_time(path[d], path[d + 1]);
+
+      return instance.get_travel_time(path[p - 1], path[p + 1]) - instance.get_travel_time(path[p - 1], path[p]) -
+             instance.get_travel_time(path[p], path[p + 1]) +
+             instance.get_travel_time(path[d - 1], path[d + 1]) - instance.get_travel_time(path[d - 1], path[d]) -
+             instance.get_travel_time(path[d], path[d + 1]);
+    }
+
+    /*
+     * Travel cost delta of inserting `pickup` and `delivery` in route `r`, so that they end up at positions
+     * `p` < `d` of the new path.
+     */
+    double insertion_delta(const Route &r, Node *pickup, int p, Node *delivery, int d)
+    {
+      Instance &instance = *r.instance;
+      const std::vector<Node*> &path = r.path;
+
+      if (d == p + 1)
+        return instance.get_travel_time(path[p - 1], pickup) + instance.get_travel_time(pickup, delivery) +
+               instance.get_travel_time(delivery, path[p]) - instance.get_travel_time(path[p - 1], path[p]);
+
+      // Delivery goes between nodes d - 2 and d - 1 of the original path
+      return instance.get_travel_time(path[p - 1], pickup) + instance.get_travel_time(pickup, path[p]) -
+             instance.get_travel_time(path[p - 1], path[p]) +
+             instance.get_travel_time(path[d - 2], delivery) + instance.get_travel_time(delivery, path[d - 1]) -
+             instance.get_travel_time(path[d - 2], path[d - 1]);
+    }
+
+    /*
+     * Travel cost delta of replacing the nodes at positions `p` < `d` of route `r` by `pickup` and `delivery`.
+     */
+    double replacement_delta(const Route &r, int p, Node *pickup, int d, Node *delivery)
+    {
+      Instance &instance = *r.instance;
+      auto node_at = [&] (int i) {
+        return i == p ? pickup : (i == d ? delivery : r.path[i]);
+      };
+
+      // Edges are identified by their head, the edge between p and d is only counted once when they're adjacent
+      int heads[4] = {p, p + 1, d + 1, d};
+      int count = d == p + 1 ? 3 : 4;
+
+      double delta = 0.0;
+
+      for (int k = 0; k < count; k++)
+        delta += instance.get_travel_time(node_at(heads[k] - 1), node_at(heads[k])) -
+                 instance.get_travel_time(r.path[heads[k] - 1], r.path[heads[k]]);
+
+      return delta;
+    }
+
+    /*
+     * Positions of route `r` where the vehicle is empty when departing, i.e. where 2-opt* may cut the route.
+     */
+    std::vector<int> get_cuts(const Route &r)
+    {
+      std::vector<int> cuts;
+
+      for (int i = 0; i < (int) r.path.size() - 1; i++)
+        if (r.load[i] == 0)
+          cuts.push_back(i);
+
+      return cuts;
+    }
+
+    /*
+     * Earliest service times along the path of route `r`, waiting only for time windows to open.
+     */
+    std::vector<double> get_earliest_times(const Route &r)
+    {
+      Instance &instance = *r.instance;
+      std::vector<double> earliest(r.path.size());
+
+      earliest[0] = r.path[0]->arrival_time;
+
+      for (int i = 1; i < (int) r.path.size(); i++)
+        earliest[i] = std::max(
+          r.path[i]->arrival_time,
+          earliest[i - 1] + r.path[i - 1]->service_time + instance.get_travel_time(r.path[i - 1], r.path[i])
+        );
+
+      return earliest;
+    }
+
+    /*
+     * Check time windows and capacity along a new path of `vehicle`, made of the nodes of route `prefix` before
+     * position `first`, changed nodes up to position `last` and then the nodes of route `suffix` from position
+     * `last + 1 + offset` on. Both routes are feasible and given with their earliest times, which are propagated
+     * from `first` on until they meet those of `suffix` with the same load, as the rest of the path is then known
+     * to fit. Passing is necessary for feasibility, ride times and route duration are left to `Route::evaluate`.
+     */
+    bool screen(const std::vector<Node*> &path, Vehicle *vehicle, int first, int last, const Route &prefix,
+                const std::vector<double> &prefix_earliest, const Route &suffix,
+                const std::vector<double> &suffix_earliest, int offset)
+    {
+      Instance &instance = *prefix.instance;
+
+      double earliest = prefix_earliest[first - 1];
+      int load = prefix.load[first - 1];
+
+      for (int i = first; i < (int) path.size(); i++) {
+        earliest = std::max(
+          path[i]->arrival_time, earliest + path[i - 1]->service_time + instance.get_travel_time(path[i - 1], path[i])
+        );
+        load += path[i]->load;
+
+        if (earliest > path[i]->departure_time || load > vehicle->capacity)
+          return false;
+
+        if (i > last && earliest <= suffix_earliest[i + offset] && load == suffix.load[i + offset])
+          return true;
+      }
+
+      return true;
+    }
+  } // namespace details
+
+  using namespace details;
+
+  Run sa(Instance &instance, int iterations, Cooling cooling, double random_param)
+  {
+    Run run;
+    double start = omp_get_wtime();
+
+    // Seed the Random engine of each thread, from std::random_device unless a seed was set
+    unsigned int seed = get_seed();
+    Random::seed(seed);
+    run.seeds.push_back(seed);
+
+    do {
+      run.init = construct_greedy_randomized_solution(instance, random_param);
+
+      if (!run.init.feasible())
+        run.init = repair(run.init);
+    }
+    while (!run.init.feasible());
+
+    // Routes left empty by the construction were never evaluated, so their schedules don't match their paths yet
+    for (auto &pair : run.init.routes)
+      pair.second.evaluate();
+
+    Solution s = run.best = run.init;
+    run.convergence.push_back({omp_get_wtime() - start, run.best.cost});
+
+    std::vector<Vehicle*> vehicles;
+    std::unordered_map<Vehicle*, std::vector<int>, VehicleHash> cuts;
+    std::unordered_map<Vehicle*, std::vector<double>, VehicleHash> earliest;
+
+    for (auto &pair : s.routes) {
+      vehicles.push_back(pair.first);
+      cuts[pair.first] = get_cuts(pair.second);
+      earliest[pair.first] = get_earliest_times(pair.second);
+    }
+
+    // Start at a temperature in which a solution 5% worse than the initial one is accepted with probability 0.5
+    double temperature = -0.05 * run.init.cost/log(0.5);
+
+    // Geometric cooling reaches a ten-thousandth of the initial temperature at the last iteration
+    double cooling_rate = pow(1e-4, 1.0/iterations);
+
+    // Adaptive cooling checks the acceptance rate of worsening moves once every segment
+    const int segment_size = 1000;
+    int worsening = 0, accepted = 0;
+
+    for (int it = 1; it <= iterations && vehicles.size() > 1 && !out_of_time(start); it++) {
+      if (cooling == Cooling::GEOMETRIC) {
+        temperature *= cooling_rate;
+      }
+      else if (it % segment_size == 0) {
+        double target = 0.5 * (1.0 - (double) it/iterations);
+
+        if (worsening > 0 && (double) accepted/worsening > target)
+          temperature *= 0.9;
+        else
+          temperature /= 0.9;
+
+        worsening = accepted = 0;
+      }
+
+      int i1 = Random::get(0, (int) vehicles.size() - 1);
+      int i2 = Random::get(0, (int) vehicles.size() - 2);
+
+      Vehicle *v1 = vehicles[i1];
+      Vehicle *v2 = vehicles[i2 < i1 ? i2 : i2 + 1];
+
+      const Route &r1 = s.routes.at(v1);
+      const Route &r2 = s.routes.at(v2);
+      int n1 = r1.path.size(), n2 = r2.path.size();
+
+      int move = Random::get(0, 2), p1 = 0, d1 = 0, p2 = 0, d2 = 0;
+      Request *req1 = nullptr, *req2 = nullptr;
+      double delta;
+
+      if (move == 0) {
+        // Relocate a request of r1 to random positions of r2
+        if (n1 <= 2)
+          continue;
+
+        req1 = instance.get_request(r1.path[Random::get(1, n1 - 2)]);
+        p1 = r1.nodes_indices.at(req1->pickup);
+        d1 = r1.nodes_indices.at(req1->delivery);
+        p2 = Random::get(1, n2 - 1);
+        d2 = Random::get(p2 + 1, n2);
+
+        delta = removal_delta(r1, p1, d1) + insertion_delta(r2, req1->pickup, p2, req1->delivery, d2);
+      }
+      else if (move == 1) {
+        // Exchange a request of r1 with a request of r2, each one taking the positions of the other
+        if (n1 <= 2 || n2 <= 2)
+          continue;
+
+        req1 = instance.get_request(r1.path[Random::get(1, n1 - 2)]);
+        req2 = instance.get_request(r2.path[Random::get(1, n2 - 2)]);
+        p1 = r1.nodes_indices.at(req1->pickup);
+        d1 = r1.nodes_indices.at(req1->delivery);
+        p2 = r2.nodes_indices.at(req2->pickup);
+        d2 = r2.nodes_indices.at(req2->delivery);
+
+        delta = replacement_delta(r1, p1, req2->pickup, d1, req2->delivery) +
+                replacement_delta(r2, p2, req1->pickup, d2, req1->delivery);
+      }
+      else {
+        // 2-opt*: swap the tails of r1 and r2 after positions where both vehicles are empty
+        const std::vector<int> &cuts1 = cuts[v1], &cuts2 = cuts[v2];
+
+        p1 = cuts1[Random::get(0, (int) cuts1.size() - 1)];
+        p2 = cuts2[Random::get(0, (int) cuts2.size() - 1)];
+
+        // Exchanging whole routes or just the final depots yields the original routes
+        if ((p1 == 0 && p2 == 0) || (p1 == n1 - 2 && p2 == n2 - 2))
+          continue;
+
+        delta = instance.get_travel_time(r1.path[p1], r2.path[p2 + 1]) + instance.get_travel_time(r2.path[p2], r1.path[p1 + 1]) -
+                instance.get_travel_time(r1.path[p1], r1.path[p1 + 1]) - instance.get_travel_time(r2.path[p2], r2.path[p2 + 1]);
+      }
+
+      if (delta > 0)
+        worsening++;
+
+      if (delta > 0 && Random::get(0.0, 1.0) >= exp(-delta/temperature))
+        continue;
+
+      if (delta > 0)
+        accepted++;
+
+      Route new_r1(&instance, v1), new_r2(&instance, v2);
+      const std::vector<double> &earliest1 = earliest[v1], &earliest2 = earliest[v2];
+      bool fits;
+
+      // Moves which passed the acceptance criterion are screened for time windows and capacity first
+      if (move == 0) {
+        new_r1.path = r1.path;
+        new_r1.path.erase(new_r1.path.begin() + d1);
+        new_r1.path.erase(new_r1.path.begin() + p1);
+
+        new_r2.path = r2.path;
+        new_r2.path.insert(new_r2.path.begin() + p2, req1->pickup);
+        new_r2.path.insert(new_r2.path.begin() + d2, req1->delivery);
+
+        fits = screen(new_r1.path, v1, p1, d1 - 2, r1, earliest1, r1, earliest1, 2) &&
+               screen(new_r2.path, v2, p2, d2, r2, earliest2, r2, earliest2, -2);
+      }
+      else if (move == 1) {
+        new_r1.path = r1.path;
+        new_r1.path[p1] = req2->pickup;
+        new_r1.path[d1] = req2->delivery;
+
+        new_r2.path = r2.path;
+        new_r2.path[p2] = req1->pickup;
+        new_r2.path[d2] = req1->delivery;
+
+        fits = screen(new_r1.path, v1, p1, d1, r1, earliest1, r1, earliest1, 0) &&
+               screen(new_r2.path, v2, p2, d2, r2, earliest2, r2, earliest2, 0);
+      }
+      else {
+        new_r1.path.insert(new_r1.path.end(), r1.path.begin(), r1.path.begin() + p1 + 1);
+        new_r1.path.insert(new_r1.path.end(), r2.path.begin() + p2 + 1, r2.path.end());
+
+        new_r2.path.insert(new_r2.path.end(), r2.path.begin(), r2.path.begin() + p2 + 1);
+        new_r2.path.insert(new_r2.path.end(), r1.path.begin() + p1 + 1, r1.path.end());
+
+        fits = screen(new_r1.path, v1, p1 + 1, p1 + 1, r1, earliest1, r2, earliest2, p2 - p1) &&
+               screen(new_r2.path, v2, p2 + 1, p2 + 1, r2, earliest2, r1, earliest1, p1 - p2);
+      }
+
+      // Only then are the routes evaluated, which also checks ride times and route durations
+      if (fits && new_r1.evaluate() && new_r2.evaluate()) {
+        s.add_route(new_r1);
+        s.add_route(new_r2);
+
+        cuts[v1] = get_cuts(s.routes[v1]);
+        cuts[v2] = get_cuts(s.routes[v2]);
+        earliest[v1] = get_earliest_times(s.routes[v1]);
+        earliest[v2] = get_earliest_times(s.routes[v2]);
+
+        if (s.cost < run.best.cost) {
+          run.best = s;
+          run.convergence.push_back({omp_get_wtime() - start, run.best.cost});
+        }
+      }
+    }
+
+    run.init.delete_empty_routes();
+    run.best.delete_empty_routes();
+
+    double finish = omp_get_wtime();
+    run.elapsed_seconds = finish - start;
+
+    return run;
+  }
+} // namespace algorithms
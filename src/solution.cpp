@@ -8,14 +8,19 @@
 #include "instance.hpp"
 
 #include <cfloat>
+#include <algorithm> // std::sort
 
-Solution::Solution()
+Solution::Solution(Instance *instance)
 {
   cost = 0.0;
+  this->instance = instance;
 }
 
 void Solution::add_route(Route r)
 {
+  if (!instance)
+    instance = r.instance;
+
   // In case we are updating the vehicle's route...
   if (routes.find(r.vehicle) != routes.end())
     cost -= routes[r.vehicle].cost;
@@ -24,9 +29,10 @@ void Solution::add_route(Route r)
   cost += r.cost;
 }
 
-bool Solution::feasible()
+bool Solution::feasible() const
 {
-  return routes.size() <= inst.vehicles.size();
+  // A solution without routes (nor instance) uses no vehicle at all
+  return !instance || routes.size() <= instance->vehicles.size();
 }
 
 void Solution::delete_empty_routes()
@@ -37,3 +43,30 @@ void Solution::delete_empty_routes()
     else
       ++it;
 }
+
+std::string Solution::to_key()
+{
+  std::vector<std::string> keys;
+
+  for (auto pair : routes) {
+    if (pair.second.empty())
+      continue;
+
+    std::string key;
+
+    for (Node *node : pair.second.path)
+      key.append(std::to_string(node->id) + ' ');
+
+    keys.push_back(key);
+  }
+
+  // Vehicles are interchangeable, so routes must be ordered to make the key unique
+  std::sort(keys.begin(), keys.end());
+
+  std::string key;
+
+  for (std::string k : keys)
+    key.append(k + '|');
+
+  return key;
+}
@@ -0,0 +1,227 @@
+/**
+ * @file   tabu.cpp
+ * @author Diego Paiva
+ * @date   18/10/2026
+ */
+
+#include "algorithms.hpp"
+#include "instance.hpp"
+
+#include <cfloat>        // FLT_MAX
+#include <cmath>         // sqrt, fabs
+#include <unordered_map> // std::unordered_map
+#include <omp.h>         // OpenMP
+
+namespace algorithms
+{
+  using namespace details;
+
+  Run tabu(Instance &instance, int iterations, int tenure, int thread_count, double diversification, double adjustment)
+  {
+    if (thread_count < 1 || thread_count > omp_get_max_threads())
+      thread_count = omp_get_max_threads();
+
+    Run run;
+    double start = omp_get_wtime();
+
+    // Randomness is only used by the constructive algorithm, which runs in the master thread
+    unsigned int seed = get_seed();
+    Random::seed(seed);
+    run.seeds.push_back(seed);
+
+    Penalty penalty;
+    // If abandoned at the deadline, the search doesn't start and a solution is built the usual way instead
+    Solution s = construct_penalized_solution(instance, penalty, get_deadline(start));
+
+    // The penalized construction is rarely feasible, so the initial solution is the first feasible one reached
+    run.init.cost = FLT_MAX;
+    run.best.cost = FLT_MAX;
+
+    // Attribute (i, k) means request i is served by vehicle k, both tabu list and frequencies are hashed by it
+    auto attribute = [] (Request *req, Vehicle *v) {
+      return ((long long) req->pickup->id << 32) | (unsigned int) v->id;
+    };
+
+    // Last iteration in which every attribute is tabu and how many times every attribute was added to a solution
+    std::unordered_map<long long, int> tabu_list, frequency;
+
+    struct Candidate {
+      int i;
+      Vehicle *v2;
+    };
+
+    std::vector<int> requests_ids;
+
+    double scale = diversification * sqrt(instance.requests.size() * instance.vehicles.size());
+
+    // Moves of equal value are ranked by request and vehicle ids, so the chosen move doesn't depend on the threads
+    auto precedes = [&] (double value1, const Candidate &c1, double value2, const Candidate &c2) {
+      if (value1 != value2)
+        return value1 < value2;
+
+      int id1 = requests_ids[c1.i], id2 = requests_ids[c2.i];
+
+      return id1 < id2 || (id1 == id2 && c1.v2->id < c2.v2->id);
+    };
+
+    for (int it = 1; it <= iterations && !out_of_time(start); it++) {
+      std::unordered_map<Request*, Vehicle*, RequestHash> assignments = get_assignments(s);
+      std::vector<Request*> requests;
+
+      for (auto &pair : assignments)
+        requests.push_back(pair.first);
+
+      requests_ids.resize(requests.size());
+
+      for (int i = 0; i < (int) requests.size(); i++)
+        requests_ids[i] = requests[i]->pickup->id;
+
+      // Routes without each request and the penalized gain of that removal
+      std::vector<Route> removals(requests.size());
+      std::vector<double> removal_deltas(requests.size());
+
+      #pragma omp parallel for schedule(dynamic) num_threads(thread_count)
+      for (int i = 0; i < (int) requests.size(); i++) {
+        const Route &r1 = s.routes.at(assignments.at(requests[i]));
+
+        removals[i] = r1;
+        removals[i].erase_request(requests[i]);
+        removals[i].evaluate(false);
+        removal_deltas[i] = penalty.cost(removals[i]) - penalty.cost(r1);
+      }
+
+      std::vector<Candidate> candidates;
+
+      for (int i = 0; i < (int) requests.size(); i++)
+        for (auto &pair : s.routes)
+          if (pair.first != assignments[requests[i]])
+            candidates.push_back({i, pair.first});
+
+      double best_value = FLT_MAX;
+      int best_candidate = -1;
+      Route best_route;
+
+      #pragma omp parallel num_threads(thread_count)
+      {
+        // Every thread bounds the insertions it evaluates by its own best move so far
+        double thread_value = FLT_MAX;
+        int thread_candidate = -1;
+        Route thread_route;
+
+        #pragma omp for schedule(dynamic)
+        for (int c = 0; c < (int) candidates.size(); c++) {
+          if (out_of_time(start))
+            continue;
+
+          Request *req = requests[candidates[c].i];
+          const Route &r2 = s.routes.at(candidates[c].v2);
+          double removal = removal_deltas[candidates[c].i];
+
+          // Diversification penalty is non-negative, so the penalized delta alone bounds the value of a move. The bound
+          // is loosened so that round-off doesn't discard moves tying with the best one
+          double bound = thread_value - removal + penalty.cost(r2);
+          Route new_r2 = get_cheapest_penalized_insertion(req, r2, penalty, bound + 1e-6 * (1.0 + fabs(bound)));
+
+          if (!new_r2.feasible())
+            continue;
+
+          double delta = removal + penalty.cost(new_r2) - penalty.cost(r2);
+          double value = delta;
+          long long key = attribute(req, candidates[c].v2);
+
+          auto tabu_it = tabu_list.find(key);
+
+          if (tabu_it != tabu_list.end() && tabu_it->second >= it) {
+            // Aspiration criterion: a tabu move is allowed only if it yields a new best solution
+            double cost = s.cost + (removals[candidates[c].i].cost - s.routes.at(assignments.at(req)).cost) +
+                          (new_r2.cost - r2.cost);
+
+            bool feasible = !violated(new_r2) && !violated(removals[candidates[c].i]);
+
+            for (auto &pair : s.routes)
+              if (pair.first != candidates[c].v2 && pair.first != assignments.at(req) && violated(pair.second))
+                feasible = false;
+
+            if (!feasible || cost >= run.best.cost)
+              continue;
+          }
+          else if (delta >= 0) {
+            // Non-improving moves are penalized by how often their attribute was added to a solution
+            auto frequency_it = frequency.find(key);
+
+            if (frequency_it != frequency.end())
+              value += scale * (s.cost + new_r2.cost - r2.cost) * frequency_it->second/it;
+          }
+
+          if (thread_candidate == -1 || precedes(value, candidates[c], thread_value, candidates[thread_candidate])) {
+            thread_value = value;
+            thread_candidate = c;
+            thread_route = new_r2;
+          }
+        }
+
+        #pragma omp critical
+        if (thread_candidate != -1 && (best_candidate == -1 ||
+            precedes(thread_value, candidates[thread_candidate], best_value, candidates[best_candidate]))) {
+          best_value = thread_value;
+          best_candidate = thread_candidate;
+          best_route = thread_route;
+        }
+      }
+
+      // The neighborhood was not fully evaluated
+      if (out_of_time(start))
+        break;
+
+      // Every move is tabu and none of them aspirates
+      if (best_candidate == -1) {
+        penalty.update(s, adjustment);
+        continue;
+      }
+
+      Candidate c = candidates[best_candidate];
+      Request *req = requests[c.i];
+
+      s.add_route(removals[c.i]);
+      s.add_route(best_route);
+
+      // Moving the request back to the route it left is forbidden for a while
+      tabu_list[attribute(req, assignments[req])] = it + tenure;
+      frequency[attribute(req, c.v2)]++;
+
+      if (!violated(s) && run.init.cost == FLT_MAX)
+        run.init = s;
+
+      if (!violated(s) && s.cost < run.best.cost) {
+        run.best = s;
+        run.convergence.push_back({omp_get_wtime() - start, run.best.cost});
+      }
+
+      penalty.update(s, adjustment);
+    }
+
+    // No feasible solution was reached, e.g. within few iterations or the time limit, so one is built the usual way
+    if (run.best.cost == FLT_MAX) {
+      do {
+        run.init = construct_greedy_randomized_solution(instance, 0.2);
+
+        if (!run.init.feasible())
+          run.init = repair(run.init);
+      }
+      while (!run.init.feasible());
+
+      run.best = run.init;
+    }
+
+    run.best = vnd(run.best, false, Strategy(), get_deadline(start));
+    run.convergence.push_back({omp_get_wtime() - start, run.best.cost});
+
+    run.init.delete_empty_routes();
+    run.best.delete_empty_routes();
+
+    double finish = omp_get_wtime();
+    run.elapsed_seconds = finish - start;
+
+    return run;
+  }
+} // namespace algorithms
@@ -0,0 +1,366 @@
+/**
+ * @file   travel_times.cpp
+ * @author Diego Paiva
+ * @date   18/10/2026
+ */
+
+#include "travel_times.hpp"
+
+#include <atomic>    // std::atomic
+#include <algorithm> // std::max, std::fill
+#include <stdexcept> // std::runtime_error, std::invalid_argument
+#include <cstring>   // std::memcmp
+#include <cmath>     // ceil, nextafterf, INFINITY
+#include <fcntl.h>   // open
+#include <unistd.h>  // close
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace
+{
+  /*
+   * Rows of a lazy provider computed by one thread, evicted by least recent use.
+   */
+  struct RowCache
+  {
+    unsigned long long owner = 0;
+    unsigned long long clock = 0;
+    std::vector<double> rows;
+    std::vector<int> tags;
+    std::vector<unsigned long long> last_use;
+  };
+
+  thread_local RowCache row_cache;
+
+  std::atomic<unsigned long long> next_uid(1);
+
+  /*
+   * Header of travel time files, whose layout is described in travel_times.hpp.
+   */
+  struct MatrixHeader
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t format;
+    int32_t nodes;
+    uint64_t entries;
+    double default_time;
+  };
+
+  const char MATRIX_MAGIC[8] = "DARPTTM";
+  const uint32_t MATRIX_VERSION = 1;
+  const uint32_t MATRIX_BYTE_ORDER = 0x01020304;
+} // namespace
+
+TravelTimes::TravelTimes() : mode(Mode::DENSE), n(0), x(nullptr), y(nullptr), matrix(nullptr), scale(0.0),
+                             offsets(nullptr), columns(nullptr), values(nullptr), default_time(0.0), mapping(nullptr),
+                             mapping_size(0), cache_rows(0)
+{
+  uid = next_uid++;
+}
+
+TravelTimes::~TravelTimes()
+{
+  if (mapping)
+    munmap(const_cast<char*>(mapping), mapping_size);
+}
+
+void TravelTimes::init(const std::vector<Node*> &nodes, Mode mode, int cache_rows)
+{
+  n = nodes.size();
+  latitudes.resize(n);
+  longitudes.resize(n);
+
+  for (Node *node : nodes) {
+    latitudes[node->index] = node->latitude;
+    longitudes[node->index] = node->longitude;
+  }
+
+  x = latitudes.data();
+  y = longitudes.data();
+
+  if (mode == Mode::SPARSE)
+    throw std::invalid_argument("sparse travel times can only be loaded from a file");
+
+  if (mode == Mode::AUTO)
+    mode = n <= max_dense_nodes ? Mode::DENSE : Mode::LAZY;
+
+  this->cache_rows = std::max(cache_rows, 2);
+
+  offsets = nullptr;
+  columns = nullptr;
+  values = nullptr;
+  matrix = nullptr;
+
+  std::vector<double>().swap(storage);
+  std::vector<double>().swap(triangle);
+  std::vector<float>().swap(floats);
+  std::vector<uint16_t>().swap(quantized);
+
+  // Rows are computed in lazy mode while filling the storage of the other modes
+  this->mode = Mode::LAZY;
+
+  if (mode == Mode::DENSE) {
+    storage.resize((size_t) n * n);
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; i++)
+      fill_row(i, &storage[(size_t) i * n]);
+
+    matrix = storage.data();
+  }
+  else if (mode == Mode::TRIANGULAR) {
+    triangle.resize((size_t) n * (n + 1)/2);
+
+    // Every row of the triangle is a prefix of a full row
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (int i = 0; i < n; i++) {
+      std::vector<double> row(n);
+      fill_row(i, row.data());
+      std::copy(row.begin(), row.begin() + i + 1, triangle.begin() + (size_t) i * (i + 1)/2);
+    }
+  }
+  else if (mode == Mode::FLOAT32 || mode == Mode::QUANTIZED) {
+    double max_time = 0.0;
+
+    #pragma omp parallel for schedule(static) reduction(max:max_time)
+    for (int i = 0; i < n; i++) {
+      std::vector<double> row(n);
+      fill_row(i, row.data());
+
+      for (int j = 0; j < n; j++)
+        max_time = std::max(max_time, row[j]);
+    }
+
+    scale = max_time > 0.0 ? max_time/UINT16_MAX : 1.0;
+
+    if (mode == Mode::FLOAT32)
+      floats.resize((size_t) n * n);
+    else
+      quantized.resize((size_t) n * n);
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; i++) {
+      std::vector<double> row(n);
+      fill_row(i, row.data());
+
+      for (int j = 0; j < n; j++) {
+        size_t k = (size_t) i * n + j;
+
+        if (mode == Mode::FLOAT32) {
+          floats[k] = row[j];
+
+          if (floats[k] < row[j])
+            floats[k] = nextafterf(floats[k], INFINITY);
+        }
+        else {
+          quantized[k] = std::min(ceil(row[j]/scale), (double) UINT16_MAX);
+        }
+      }
+    }
+  }
+
+  this->mode = mode;
+}
+
+void TravelTimes::load(const std::vector<Node*> &nodes, const std::string &file_name)
+{
+  auto fail = [&] (const std::string &message) {
+    throw std::runtime_error(file_name + ": " + message);
+  };
+
+  int fd = open(file_name.c_str(), O_RDONLY);
+  struct stat st;
+
+  if (fd < 0 || fstat(fd, &st) < 0) {
+    if (fd >= 0)
+      close(fd);
+
+    fail("failed to read file");
+  }
+
+  if (st.st_size < (off_t) sizeof(MatrixHeader)) {
+    close(fd);
+    fail("missing header");
+  }
+
+  void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+
+  if (data == MAP_FAILED)
+    fail("failed to map file");
+
+  // Set up the nodes without any storage, which the mapped matrix then takes over
+  init(nodes, Mode::LAZY);
+
+  if (mapping)
+    munmap(const_cast<char*>(mapping), mapping_size);
+
+  mapping = static_cast<const char*>(data);
+  mapping_size = st.st_size;
+
+  const MatrixHeader *header = reinterpret_cast<const MatrixHeader*>(mapping);
+  const char *body = mapping + sizeof(MatrixHeader);
+  size_t size = mapping_size - sizeof(MatrixHeader);
+
+  if (std::memcmp(header->magic, MATRIX_MAGIC, sizeof(MATRIX_MAGIC)) != 0)
+    fail("not a travel time file");
+
+  if (header->version != MATRIX_VERSION || header->byte_order != MATRIX_BYTE_ORDER)
+    fail("unsupported version or byte order");
+
+  if (header->nodes != n)
+    fail("expected " + std::to_string(n) + " nodes, found " + std::to_string(header->nodes));
+
+  if (header->format == 0) {
+    if (header->entries != (uint64_t) n * n || size != header->entries * sizeof(double))
+      fail("size doesn't match a dense matrix");
+
+    mode = Mode::DENSE;
+    matrix = reinterpret_cast<const double*>(body);
+  }
+  else if (header->format == 1) {
+    size_t columns_size = (header->entries * sizeof(int32_t) + 7)/8 * 8;
+
+    if (size != (n + 1) * sizeof(uint64_t) + columns_size + header->entries * sizeof(double))
+      fail("size doesn't match a sparse matrix");
+
+    offsets = reinterpret_cast<const uint64_t*>(body);
+    columns = reinterpret_cast<const int32_t*>(offsets + n + 1);
+    values = reinterpret_cast<const double*>(body + (n + 1) * sizeof(uint64_t) + columns_size);
+    default_time = header->default_time;
+
+    if (offsets[0] != 0 || offsets[n] != header->entries)
+      fail("invalid row offsets");
+
+    // Lookups rely on sorted columns, so rows are checked once while loading
+    for (int i = 0; i < n; i++) {
+      if (offsets[i + 1] < offsets[i])
+        fail("invalid row offsets");
+
+      for (uint64_t k = offsets[i]; k < offsets[i + 1]; k++)
+        if (columns[k] < 0 || columns[k] >= n || (k > offsets[i] && columns[k] <= columns[k - 1]))
+          fail("invalid columns in row " + std::to_string(i));
+    }
+
+    mode = Mode::SPARSE;
+  }
+  else {
+    fail("unknown format " + std::to_string(header->format));
+  }
+
+  madvise(data, mapping_size, MADV_RANDOM);
+}
+
+void TravelTimes::init(const std::vector<Node*> &nodes, const double *matrix)
+{
+  init(nodes, Mode::LAZY);
+
+  this->mode = Mode::DENSE;
+  this->matrix = matrix;
+}
+
+TravelTimes::Mode TravelTimes::get_mode() const
+{
+  return mode;
+}
+
+bool TravelTimes::is_stored() const
+{
+  return mode == Mode::DENSE || mode == Mode::TRIANGULAR || mode == Mode::FLOAT32 || mode == Mode::QUANTIZED;
+}
+
+bool TravelTimes::is_euclidean() const
+{
+  return !mapping;
+}
+
+bool TravelTimes::is_rounded() const
+{
+  return mode == Mode::FLOAT32 || mode == Mode::QUANTIZED;
+}
+
+size_t TravelTimes::get_size() const
+{
+  return storage.size() * sizeof(double) + triangle.size() * sizeof(double) + floats.size() * sizeof(float) +
+         quantized.size() * sizeof(uint16_t) + (latitudes.size() + longitudes.size()) * sizeof(double);
+}
+
+size_t TravelTimes::get_cache_size() const
+{
+  return matrix ? 0 : (size_t) cache_rows * n * sizeof(double);
+}
+
+const double* TravelTimes::data() const
+{
+  return matrix;
+}
+
+const double* TravelTimes::row(int i) const
+{
+  if (matrix)
+    return matrix + (size_t) i * n;
+
+  RowCache &cache = row_cache;
+
+  if (cache.owner != uid) {
+    cache.owner = uid;
+    cache.clock = 0;
+    cache.rows.assign((size_t) cache_rows * n, 0.0);
+    cache.tags.assign(cache_rows, -1);
+    cache.last_use.assign(cache_rows, 0);
+  }
+
+  // Caches are small, so a linear scan is cheaper than hashing
+  int slot = 0;
+
+  for (int k = 0; k < cache_rows; k++) {
+    if (cache.tags[k] == i) {
+      cache.last_use[k] = ++cache.clock;
+      return &cache.rows[(size_t) k * n];
+    }
+
+    if (cache.last_use[k] < cache.last_use[slot])
+      slot = k;
+  }
+
+  fill_row(i, &cache.rows[(size_t) slot * n]);
+  cache.tags[slot] = i;
+  cache.last_use[slot] = ++cache.clock;
+
+  return &cache.rows[(size_t) slot * n];
+}
+
+void TravelTimes::fill_row(int i, double *out) const
+{
+  if (matrix) {
+    std::copy(matrix + (size_t) i * n, matrix + (size_t) (i + 1) * n, out);
+    return;
+  }
+
+  if (columns) {
+    std::fill(out, out + n, default_time);
+    out[i] = 0.0;
+
+    for (uint64_t k = offsets[i]; k < offsets[i + 1]; k++)
+      out[columns[k]] = values[k];
+
+    return;
+  }
+
+  if (mode != Mode::LAZY) {
+    for (int j = 0; j < n; j++)
+      out[j] = get(i, j);
+
+    return;
+  }
+
+  const double xi = x[i], yi = y[i];
+
+  #pragma omp simd
+  for (int j = 0; j < n; j++) {
+    double dx = xi - x[j], dy = yi - y[j];
+    out[j] = sqrt(dx * dx + dy * dy);
+  }
+}